@@ -0,0 +1,105 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "core/algorithms/include/adjacent.hpp"
+#include "core/threading/include/thread_pool.hpp"
+
+namespace {
+
+std::vector<int> random_values(size_t size, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(-20, 20);
+  std::vector<int> values(size);
+  for (auto& value : values) {
+    value = dist(gen);
+  }
+  return values;
+}
+
+auto descending = [](int left, int right) { return left > right; };
+auto distance = [](int left, int right) { return std::abs(left - right); };
+
+}  // namespace
+
+TEST(adjacent_tests, check_count_matches_naive_loop) {
+  ppc::core::ThreadPool pool(3);
+  for (size_t size : {0, 1, 2, 3, 10, 101, 1000}) {
+    auto values = random_values(size, static_cast<unsigned>(size));
+    size_t expected = 0;
+    for (size_t i = 0; i + 1 < size; i++) {
+      expected += values[i] > values[i + 1] ? 1 : 0;
+    }
+    std::span<const int> view(values);
+    EXPECT_EQ(ppc::core::count_adjacent_if(view, descending), expected);
+    for (int num_threads : {1, 2, 4, 7}) {
+      EXPECT_EQ(ppc::core::count_adjacent_if(pool, view, descending, num_threads), expected)
+          << size << " values on " << num_threads << " threads";
+    }
+  }
+}
+
+TEST(adjacent_tests, check_pairs_across_chunk_borders_are_counted_once) {
+  // 8 pairs split into 2 chunks of 4: last pair of first chunk reads value 9 owned by second chunk,
+  // which starts with the only descending and most different pair (9, 1)
+  std::vector<int> values = {0, 1, 2, 3, 9, 1, 6, 7, 8};
+  ppc::core::ThreadPool pool(1);
+  std::span<const int> view(values);
+  EXPECT_EQ(ppc::core::count_adjacent_if(view, descending), 1u);
+  EXPECT_EQ(ppc::core::count_adjacent_if(pool, view, descending, 2), 1u);
+  auto largest = ppc::core::extremum_adjacent_by(pool, view, distance, std::greater<>(), 2);
+  EXPECT_EQ(largest.index, 4u);
+  EXPECT_EQ(largest.key, 8);
+}
+
+TEST(adjacent_tests, check_extremum_matches_naive_loop) {
+  ppc::core::ThreadPool pool(3);
+  for (size_t size : {2, 3, 10, 101, 1000}) {
+    auto values = random_values(size, static_cast<unsigned>(size));
+    std::vector<int> differences;
+    for (size_t i = 0; i + 1 < size; i++) {
+      differences.push_back(distance(values[i], values[i + 1]));
+    }
+    auto expected_min = std::min_element(differences.begin(), differences.end()) - differences.begin();
+    auto expected_max = std::max_element(differences.begin(), differences.end()) - differences.begin();
+
+    std::span<const int> view(values);
+    EXPECT_EQ(ppc::core::extremum_adjacent_by(view, distance, std::less<>()).index,
+              static_cast<size_t>(expected_min));
+    EXPECT_EQ(ppc::core::extremum_adjacent_by(view, distance, std::greater<>()).index,
+              static_cast<size_t>(expected_max));
+    for (int num_threads : {1, 2, 4, 7}) {
+      EXPECT_EQ(ppc::core::extremum_adjacent_by(pool, view, distance, std::less<>(), num_threads).index,
+                static_cast<size_t>(expected_min));
+      EXPECT_EQ(ppc::core::extremum_adjacent_by(pool, view, distance, std::greater<>(), num_threads).index,
+                static_cast<size_t>(expected_max));
+    }
+  }
+}
+
+TEST(adjacent_tests, check_first_pair_wins_over_chunks) {
+  // equal smallest differences in every chunk, the first one has to be reported
+  std::vector<int> values = {10, 0, 5, 5, 20, 0, 7, 7, 30};
+  ppc::core::ThreadPool pool(3);
+  for (int num_threads : {1, 2, 4}) {
+    auto result = ppc::core::extremum_adjacent_by(pool, std::span<const int>(values), distance, std::less<>(),
+                                                  num_threads);
+    EXPECT_EQ(result.index, 2u);
+    EXPECT_EQ(result.key, 0);
+  }
+}
+
+TEST(adjacent_tests, check_no_pairs) {
+  std::vector<int> values = {42};
+  ppc::core::ThreadPool pool(1);
+  std::span<const int> view(values);
+  EXPECT_EQ(ppc::core::count_adjacent_if(view, descending), 0u);
+  EXPECT_TRUE(ppc::core::extremum_adjacent_by(view, distance, std::less<>()).empty);
+  EXPECT_TRUE(ppc::core::extremum_adjacent_by(pool, view, distance, std::less<>(), 4).empty);
+}
@@ -0,0 +1,97 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_ADJACENT_HPP_
+#define MODULES_CORE_INCLUDE_ADJACENT_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <type_traits>
+
+#include "core/threading/include/thread_pool.hpp"
+#include "core/threading/include/threading.hpp"
+
+namespace ppc::core {
+
+// Kernels over adjacent pairs (values[i], values[i + 1]) in a single streaming pass, without
+// shifted copies or per-pair temporaries. Pair i is identified by index of its left element.
+// Parallel versions split pairs (not elements) into chunks, so a pair crossing the border of
+// chunks is read by the chunk owning its left element and every pair is counted exactly once.
+
+template <typename T>
+size_t num_adjacent_pairs(std::span<const T> values) {
+  return values.size() < 2 ? 0 : values.size() - 1;
+}
+
+// Count of pairs in [first_pair, last_pair) satisfying pred(left, right)
+template <typename T, typename Pred>
+size_t count_adjacent_if(std::span<const T> values, size_t first_pair, size_t last_pair, Pred pred) {
+  size_t count = 0;
+  for (auto i = first_pair; i < last_pair; i++) {
+    count += pred(values[i], values[i + 1]) ? 1 : 0;
+  }
+  return count;
+}
+
+template <typename T, typename Pred>
+size_t count_adjacent_if(std::span<const T> values, Pred pred) {
+  return count_adjacent_if(values, 0, num_adjacent_pairs(values), pred);
+}
+
+template <typename T, typename Pred>
+size_t count_adjacent_if(ThreadPool& pool, std::span<const T> values, Pred pred, int num_threads = get_num_threads()) {
+  return pool.parallel_reduce(
+      size_t{0}, num_adjacent_pairs(values), size_t{0},
+      [&](size_t first_pair, size_t last_pair, size_t count) {
+        return count + count_adjacent_if(values, first_pair, last_pair, pred);
+      },
+      std::plus<>(), num_threads);
+}
+
+// Pair with the best key(left, right) and index of its left element, empty if there are no pairs
+template <typename Key>
+struct AdjacentExtremum {
+  size_t index = 0;
+  Key key{};
+  bool empty = true;
+};
+
+// First pair with the best key in [first_pair, last_pair): a pair replaces current one only if
+// better(key, current key) holds, as in std::min_element (std::less) and std::max_element (std::greater)
+template <typename T, typename KeyOf, typename Better>
+auto extremum_adjacent_by(std::span<const T> values, size_t first_pair, size_t last_pair, KeyOf key_of,
+                          Better better) {
+  AdjacentExtremum<std::invoke_result_t<KeyOf, const T&, const T&>> result;
+  for (auto i = first_pair; i < last_pair; i++) {
+    auto key = key_of(values[i], values[i + 1]);
+    if (result.empty || better(key, result.key)) {
+      result = {i, key, false};
+    }
+  }
+  return result;
+}
+
+template <typename T, typename KeyOf, typename Better>
+auto extremum_adjacent_by(std::span<const T> values, KeyOf key_of, Better better) {
+  return extremum_adjacent_by(values, 0, num_adjacent_pairs(values), key_of, better);
+}
+
+// Chunks are combined in order and a later chunk wins only if strictly better, so the first pair is found
+template <typename T, typename KeyOf, typename Better>
+auto extremum_adjacent_by(ThreadPool& pool, std::span<const T> values, KeyOf key_of, Better better,
+                          int num_threads = get_num_threads()) {
+  using Extremum = AdjacentExtremum<std::invoke_result_t<KeyOf, const T&, const T&>>;
+  return pool.parallel_reduce(
+      size_t{0}, num_adjacent_pairs(values), Extremum{},
+      [&](size_t first_pair, size_t last_pair, const Extremum&) {
+        return extremum_adjacent_by(values, first_pair, last_pair, key_of, better);
+      },
+      [&](const Extremum& lhs, const Extremum& rhs) {
+        return rhs.empty || (!lhs.empty && !better(rhs.key, lhs.key)) ? lhs : rhs;
+      },
+      num_threads);
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_ADJACENT_HPP_
@@ -0,0 +1,116 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/backend/include/backend.hpp"
+#include "core/task/include/task.hpp"
+
+namespace {
+
+// Writes Id times factor given to constructor, so test can tell which implementation was created
+template <int Id>
+class IdTask : public ppc::core::Task {
+ public:
+  IdTask(std::shared_ptr<ppc::core::TaskData> taskData_, int factor_) : Task(std::move(taskData_)), factor(factor_) {}
+  bool validation() override {
+    internal_order_test();
+    return taskData->outputs_count[0] == 1;
+  }
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+  bool run() override {
+    internal_order_test();
+    taskData->output_view<int>(0)[0] = Id * factor;
+    return true;
+  }
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+ private:
+  int factor;
+};
+
+using Registry = ppc::core::BackendRegistry<int>;
+
+Registry make_registry() {
+  Registry registry;
+  registry.add<IdTask<1>>("sum", "seq");
+  registry.add<IdTask<2>>("sum", "omp");
+  registry.add<IdTask<3>>("sum", "tbb");
+  return registry;
+}
+
+int run_task(const Registry& registry, const std::string& backend) {
+  std::vector<int> out(1, 0);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  taskData->backend = backend;
+  auto task = registry.create("sum", taskData, 10);
+  EXPECT_TRUE(task->validation());
+  task->pre_processing();
+  task->run();
+  task->post_processing();
+  return out[0];
+}
+
+}  // namespace
+
+TEST(backend_tests, check_backend_from_task_data) {
+  auto registry = make_registry();
+  EXPECT_EQ(registry.backends("sum"), (std::vector<std::string>{"seq", "omp", "tbb"}));
+  EXPECT_EQ(run_task(registry, "seq"), 10);
+  EXPECT_EQ(run_task(registry, "omp"), 20);
+  EXPECT_EQ(run_task(registry, "tbb"), 30);
+  EXPECT_THROW(run_task(registry, "mpi"), std::invalid_argument);
+}
+
+TEST(backend_tests, check_default_backend) {
+  auto registry = make_registry();
+  ppc::core::set_default_backend("tbb");
+  EXPECT_EQ(run_task(registry, ""), 30);
+  // attribute of TaskData wins over default
+  EXPECT_EQ(run_task(registry, "omp"), 20);
+  // default missing in task falls back to the first registered backend
+  ppc::core::set_default_backend("stl");
+  EXPECT_EQ(run_task(registry, ""), 10);
+  ppc::core::set_default_backend("");
+}
+
+TEST(backend_tests, check_backend_flag) {
+  std::string program = "tests";
+  std::string filter = "--gtest_filter=*";
+  std::string flag = "--backend=omp";
+  std::string separate_flag = "--backend";
+  std::string separate_value = "tbb";
+  std::vector<char*> argv = {program.data(), flag.data(), filter.data(), nullptr};
+  int argc = 3;
+  ppc::core::parse_backend_flag(argc, argv.data());
+  EXPECT_EQ(argc, 2);
+  EXPECT_EQ(std::string(argv[1]), filter);
+  EXPECT_EQ(ppc::core::default_backend(), "omp");
+
+  argv = {program.data(), separate_flag.data(), separate_value.data(), nullptr};
+  argc = 3;
+  ppc::core::parse_backend_flag(argc, argv.data());
+  EXPECT_EQ(argc, 1);
+  EXPECT_EQ(ppc::core::default_backend(), "tbb");
+  ppc::core::set_default_backend("");
+}
+
+TEST(backend_tests, check_registration_errors) {
+  auto registry = make_registry();
+  EXPECT_THROW(registry.add<IdTask<4>>("sum", "omp"), std::invalid_argument);
+  EXPECT_THROW(registry.add<IdTask<4>>("sum", ""), std::invalid_argument);
+  EXPECT_TRUE(registry.backends("product").empty());
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  EXPECT_THROW(auto unused = registry.create("product", taskData, 1), std::invalid_argument);
+}
@@ -0,0 +1,109 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BACKEND_HPP_
+#define MODULES_CORE_INCLUDE_BACKEND_HPP_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Backend requested for the whole process: value of --backend flag if it was parsed, otherwise
+// PPC_BACKEND environment variable, empty if neither is set
+std::string default_backend();
+
+// Override default backend, empty value restores PPC_BACKEND
+void set_default_backend(std::string backend);
+
+// Take --backend=<name> or --backend <name> out of command line and make it default backend,
+// call it before testing::InitGoogleTest
+void parse_backend_flag(int& argc, char** argv);
+
+// Backend of task chosen from available ones (in order of registration): requested name if it is
+// not empty, otherwise default backend if task has it, otherwise the first one. Throws
+// std::invalid_argument if requested backend isn't available or there are no backends at all.
+std::string select_backend(std::string_view task, std::string_view requested,
+                           const std::vector<std::string>& available);
+
+// Several implementations of the same task registered under one task name and created by name of
+// backend chosen at runtime, so one binary can run any backend it was linked with:
+//   registry.add<SumSequential>("sum", "seq");
+//   registry.add<SumOpenMP>("sum", "omp");
+//   taskData->backend = "omp";  // or --backend=omp, or PPC_BACKEND=omp
+//   auto task = registry.create("sum", taskData);
+// Args are extra constructor arguments passed to every implementation after TaskData.
+// Registration isn't synchronized, register backends before creating tasks from several threads.
+template <class... Args>
+class BackendRegistry {
+ public:
+  using Factory = std::function<std::shared_ptr<Task>(std::shared_ptr<TaskData>, Args...)>;
+
+  static BackendRegistry& global() {
+    static BackendRegistry registry;
+    return registry;
+  }
+
+  void add(const std::string& task, const std::string& backend, Factory factory) {
+    if (backend.empty()) {
+      throw std::invalid_argument("Backend of task " + task + " needs a name");
+    }
+    auto& entries = tasks_[task];
+    for (const auto& entry : entries) {
+      if (entry.backend == backend) {
+        throw std::invalid_argument("Backend " + backend + " of task " + task + " is already registered");
+      }
+    }
+    entries.push_back({backend, std::move(factory)});
+  }
+
+  template <class Implementation>
+  void add(const std::string& task, const std::string& backend) {
+    add(task, backend, [](std::shared_ptr<TaskData> taskData, Args... args) -> std::shared_ptr<Task> {
+      return std::make_shared<Implementation>(std::move(taskData), std::move(args)...);
+    });
+  }
+
+  [[nodiscard]] std::vector<std::string> backends(std::string_view task) const {
+    std::vector<std::string> names;
+    if (auto it = tasks_.find(task); it != tasks_.end()) {
+      for (const auto& entry : it->second) {
+        names.push_back(entry.backend);
+      }
+    }
+    return names;
+  }
+
+  [[nodiscard]] std::string select(std::string_view task, const TaskData& taskData) const {
+    return select_backend(task, taskData.backend, backends(task));
+  }
+
+  [[nodiscard]] std::shared_ptr<Task> create(std::string_view task, std::shared_ptr<TaskData> taskData,
+                                             Args... args) const {
+    auto backend = select(task, *taskData);
+    for (const auto& entry : tasks_.find(task)->second) {
+      if (entry.backend == backend) {
+        return entry.factory(std::move(taskData), std::move(args)...);
+      }
+    }
+    return nullptr;
+  }
+
+ private:
+  struct Entry {
+    std::string backend;
+    Factory factory;
+  };
+  std::map<std::string, std::vector<Entry>, std::less<>> tasks_;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BACKEND_HPP_
@@ -0,0 +1,78 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/backend/include/backend.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+
+namespace {
+
+std::mutex default_backend_mutex;
+std::optional<std::string> default_backend_override;
+
+std::string join(const std::vector<std::string>& names) {
+  std::string result;
+  for (const auto& name : names) {
+    result += (result.empty() ? "" : ", ") + name;
+  }
+  return result;
+}
+
+}  // namespace
+
+std::string ppc::core::default_backend() {
+  {
+    std::lock_guard lock(default_backend_mutex);
+    if (default_backend_override) {
+      return *default_backend_override;
+    }
+  }
+  const char* env = std::getenv("PPC_BACKEND");
+  return env != nullptr ? env : "";
+}
+
+void ppc::core::set_default_backend(std::string backend) {
+  std::lock_guard lock(default_backend_mutex);
+  if (backend.empty()) {
+    default_backend_override.reset();
+  } else {
+    default_backend_override = std::move(backend);
+  }
+}
+
+void ppc::core::parse_backend_flag(int& argc, char** argv) {
+  const std::string_view flag = "--backend";
+  int kept = 1;
+  for (int i = 1; i < argc; i++) {
+    std::string_view arg = argv[i];
+    if (arg.starts_with(flag) && arg.size() > flag.size() && arg[flag.size()] == '=') {
+      set_default_backend(std::string(arg.substr(flag.size() + 1)));
+    } else if (arg == flag && i + 1 < argc) {
+      set_default_backend(argv[++i]);
+    } else {
+      argv[kept++] = argv[i];
+    }
+  }
+  argc = kept;
+  argv[argc] = nullptr;
+}
+
+std::string ppc::core::select_backend(std::string_view task, std::string_view requested,
+                                      const std::vector<std::string>& available) {
+  if (available.empty()) {
+    throw std::invalid_argument("Task " + std::string(task) + " has no registered backends");
+  }
+  auto has = [&](std::string_view name) {
+    return std::find(available.begin(), available.end(), name) != available.end();
+  };
+  if (!requested.empty()) {
+    if (!has(requested)) {
+      throw std::invalid_argument("Task " + std::string(task) + " has no backend " + std::string(requested) +
+                                  ", available: " + join(available));
+    }
+    return std::string(requested);
+  }
+  auto fallback = default_backend();
+  return has(fallback) ? fallback : available.front();
+}
@@ -0,0 +1,151 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/dataset/include/dataset.hpp"
+#include "core/task/include/task.hpp"
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+  return (std::filesystem::temp_directory_path() / ("ppc_dataset_" + name + ".bin")).string();
+}
+
+}  // namespace
+
+TEST(dataset_tests, check_data_types) {
+  EXPECT_EQ(ppc::core::data_type_of<int8_t>(), ppc::core::DataType::INT8);
+  EXPECT_EQ(ppc::core::data_type_of<uint16_t>(), ppc::core::DataType::UINT16);
+  EXPECT_EQ(ppc::core::data_type_of<int32_t>(), ppc::core::DataType::INT32);
+  EXPECT_EQ(ppc::core::data_type_of<uint64_t>(), ppc::core::DataType::UINT64);
+  EXPECT_EQ(ppc::core::data_type_of<float>(), ppc::core::DataType::FLOAT32);
+  EXPECT_EQ(ppc::core::data_type_of<double>(), ppc::core::DataType::FLOAT64);
+  EXPECT_EQ(ppc::core::data_type_size(ppc::core::DataType::UINT8), 1u);
+  EXPECT_EQ(ppc::core::data_type_size(ppc::core::DataType::INT16), 2u);
+  EXPECT_EQ(ppc::core::data_type_size(ppc::core::DataType::FLOAT32), 4u);
+  EXPECT_EQ(ppc::core::data_type_size(ppc::core::DataType::INT64), 8u);
+  EXPECT_EQ(ppc::core::data_type_size(ppc::core::DataType::FLOAT64), 8u);
+}
+
+TEST(dataset_tests, check_write_and_map) {
+  auto path = temp_path("matrix");
+  std::vector<double> values(12);
+  std::iota(values.begin(), values.end(), 0.5);
+  ppc::core::write_dataset(path, std::span<const double>(values), {3, 4});
+
+  ppc::core::MappedDataset dataset(path);
+  EXPECT_EQ(dataset.type(), ppc::core::DataType::FLOAT64);
+  EXPECT_EQ(dataset.shape(), (std::vector<uint64_t>{3, 4}));
+  EXPECT_EQ(dataset.size(), 12u);
+  // data starts at page boundary, so it's aligned for any element type
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(dataset.data()) % 64, 0u);
+  auto view = dataset.view<double>();
+  EXPECT_EQ(std::vector<double>(view.begin(), view.end()), values);
+  EXPECT_THROW(static_cast<void>(dataset.view<float>()), std::runtime_error);
+
+  // moved dataset keeps mapping alive
+  auto moved = std::move(dataset);
+  EXPECT_EQ(moved.view<double>()[11], 11.5);
+  std::remove(path.c_str());
+}
+
+TEST(dataset_tests, check_attach_input) {
+  auto path = temp_path("input");
+  std::vector<int32_t> values = {4, 8, 15, 16, 23, 42};
+  ppc::core::write_dataset(path, std::span<const int32_t>(values), {}, 64);
+  {
+    ppc::core::MappedDataset dataset(path, ppc::core::MappedDataset::Access::RANDOM);
+    ppc::core::TaskData taskData;
+    dataset.attach_input(taskData);
+    EXPECT_TRUE(taskData.borrow_inputs);
+    ASSERT_EQ(taskData.inputs_count[0], 6u);
+    auto input = taskData.input_view<int32_t>(0);
+    EXPECT_EQ(std::accumulate(input.begin(), input.end(), 0), 108);
+
+    // writes through input stay private to the process
+    reinterpret_cast<int32_t*>(taskData.inputs[0])[0] = -1;
+  }
+  ppc::core::MappedDataset dataset(path);
+  EXPECT_EQ(dataset.view<int32_t>()[0], 4);
+  std::remove(path.c_str());
+}
+
+TEST(dataset_tests, check_empty_dataset) {
+  auto path = temp_path("empty");
+  ppc::core::write_dataset(path, std::span<const float>());
+  ppc::core::MappedDataset dataset(path, ppc::core::MappedDataset::Access::WILL_NEED);
+  EXPECT_EQ(dataset.size(), 0u);
+  EXPECT_TRUE(dataset.view<float>().empty());
+  std::remove(path.c_str());
+}
+
+TEST(dataset_tests, check_invalid_files) {
+  EXPECT_THROW(ppc::core::MappedDataset(temp_path("missing")), std::runtime_error);
+
+  std::vector<uint8_t> bytes(10, 1);
+  EXPECT_THROW(ppc::core::write_dataset(temp_path("shape"), std::span<const uint8_t>(bytes), {3, 3}),
+               std::runtime_error);
+
+  auto path = temp_path("truncated");
+  std::vector<int64_t> values(100, 7);
+  ppc::core::write_dataset(path, std::span<const int64_t>(values));
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+  EXPECT_THROW(ppc::core::MappedDataset{path}, std::runtime_error);
+
+  std::ofstream(path, std::ios::binary | std::ios::trunc) << std::string(100, 'x');
+  EXPECT_THROW(ppc::core::MappedDataset{path}, std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(dataset_tests, check_foreign_byte_order) {
+  auto path = temp_path("byte_order");
+  std::vector<int32_t> values(100, 7);
+  ppc::core::write_dataset(path, std::span<const int32_t>(values));
+  ASSERT_EQ(ppc::core::MappedDataset(path).size(), values.size());
+
+  // marker as a host of other byte order would have written it
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    auto marker = ppc::core::DatasetHeader::kSwappedByteOrder;
+    file.seekp(offsetof(ppc::core::DatasetHeader, byte_order));
+    file.write(reinterpret_cast<const char*>(&marker), sizeof(marker));
+  }
+  EXPECT_THROW(ppc::core::MappedDataset{path}, std::runtime_error);
+  std::remove(path.c_str());
+}
+
+TEST(dataset_tests, check_stream_chunks) {
+  auto path = temp_path("stream");
+  std::vector<int64_t> values(10007);
+  std::iota(values.begin(), values.end(), -3);
+  // data offset isn't page aligned, so windows of mmap mode start inside pages
+  ppc::core::write_dataset(path, std::span<const int64_t>(values), {}, 64);
+  for (auto mode : {ppc::core::DatasetStream::Mode::READ, ppc::core::DatasetStream::Mode::MMAP}) {
+    ppc::core::DatasetChunkSource<int64_t> source(path, 1000, mode);
+    EXPECT_EQ(source.size(), values.size());
+    for (int pass = 0; pass < 2; pass++) {
+      source.rewind();
+      std::vector<int64_t> streamed;
+      size_t num_chunks = 0;
+      for (auto chunk = source.next(); !chunk.empty(); chunk = source.next()) {
+        EXPECT_LE(chunk.size(), 1000u);
+        streamed.insert(streamed.end(), chunk.begin(), chunk.end());
+        num_chunks++;
+      }
+      EXPECT_EQ(num_chunks, 11u);
+      EXPECT_EQ(streamed, values);
+    }
+  }
+  EXPECT_THROW(ppc::core::DatasetChunkSource<int32_t>(path, 10), std::runtime_error);
+  std::remove(path.c_str());
+}
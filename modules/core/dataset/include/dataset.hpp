@@ -0,0 +1,182 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_DATASET_HPP_
+#define MODULES_CORE_INCLUDE_DATASET_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "core/task/include/streaming_task.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Binary dataset file: 64-byte DatasetHeader followed by row-major elements starting at data_offset,
+// which is a multiple of alignment given on writing (page size by default), so mapped data is aligned
+// as well and can be used in place. Header and elements are stored in byte order of the writing host,
+// a file written on a host of other byte order is rejected by its byte_order marker.
+enum class DataType : uint32_t { INT8, UINT8, INT16, UINT16, INT32, UINT32, INT64, UINT64, FLOAT32, FLOAT64 };
+
+const char* data_type_name(DataType type);
+size_t data_type_size(DataType type);
+
+template <class T>
+constexpr DataType data_type_of() {
+  static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>, "Dataset element has to be a number");
+  if constexpr (std::is_floating_point_v<T>) {
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Dataset supports float and double only");
+    return sizeof(T) == 4 ? DataType::FLOAT32 : DataType::FLOAT64;
+  } else {
+    constexpr uint32_t index = sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 2 : sizeof(T) == 4 ? 4 : 6;
+    return static_cast<DataType>(index + (std::is_signed_v<T> ? 0 : 1));
+  }
+}
+
+struct DatasetHeader {
+  static constexpr char kMagic[8] = {'P', 'P', 'C', 'D', 'A', 'T', 'A', '\0'};
+  static constexpr uint32_t kVersion = 2;
+  // reads as kSwappedByteOrder on a host of other byte order
+  static constexpr uint32_t kByteOrder = 0x01020304;
+  static constexpr uint32_t kSwappedByteOrder = 0x04030201;
+  static constexpr size_t kMaxRank = 4;
+
+  char magic[8] = {};
+  uint32_t version = kVersion;
+  DataType type = DataType::UINT8;
+  // count of used dimensions of shape, the rest of them are zero
+  uint32_t rank = 1;
+  uint32_t byte_order = kByteOrder;
+  uint64_t shape[kMaxRank] = {};
+  uint64_t data_offset = 0;
+
+  [[nodiscard]] uint64_t num_elements() const;
+};
+static_assert(sizeof(DatasetHeader) == 64, "Dataset header has to be 64 bytes");
+
+// Write elements as dataset of given shape (one dimension of data.size() if empty),
+// alignment of data has to be a power of two, 0 selects page size
+void write_dataset(const std::string& path, DataType type, std::span<const uint8_t> bytes,
+                   const std::vector<uint64_t>& shape = {}, size_t alignment = 0);
+
+template <class T>
+void write_dataset(const std::string& path, std::span<const T> data, std::vector<uint64_t> shape = {},
+                   size_t alignment = 0) {
+  if (shape.empty()) {
+    shape.push_back(data.size());
+  }
+  std::span<const uint8_t> bytes(reinterpret_cast<const uint8_t*>(data.data()), data.size_bytes());
+  write_dataset(path, data_type_of<T>(), bytes, shape, alignment);
+}
+
+// Read-only view of dataset file mapped into memory without copying, pages are loaded lazily by the
+// kernel with read-ahead according to access hint. Mapping is private: writes through inputs stay in
+// the process and never reach the file. Falls back to reading the file where mmap isn't available.
+class MappedDataset {
+ public:
+  enum class Access : uint8_t { SEQUENTIAL, RANDOM, WILL_NEED };
+
+  explicit MappedDataset(const std::string& path, Access access = Access::SEQUENTIAL);
+  MappedDataset(MappedDataset&& other) noexcept;
+  MappedDataset& operator=(MappedDataset&& other) noexcept;
+  MappedDataset(const MappedDataset&) = delete;
+  MappedDataset& operator=(const MappedDataset&) = delete;
+  ~MappedDataset();
+
+  [[nodiscard]] const DatasetHeader& header() const { return header_; }
+  [[nodiscard]] DataType type() const { return header_.type; }
+  [[nodiscard]] std::vector<uint64_t> shape() const;
+  [[nodiscard]] uint64_t size() const { return header_.num_elements(); }
+  [[nodiscard]] uint8_t* data() const { return data_; }
+
+  template <class T>
+  [[nodiscard]] std::span<const T> view() const {
+    if (data_type_of<T>() != type()) {
+      throw std::runtime_error(std::string("Dataset holds ") + data_type_name(type()) + ", not " +
+                               data_type_name(data_type_of<T>()));
+    }
+    return {reinterpret_cast<const T*>(data_), static_cast<size_t>(size())};
+  }
+
+  // Append mapped elements as the next input of taskData and let task borrow it in place,
+  // dataset has to outlive the task
+  void attach_input(TaskData& taskData) const;
+
+ private:
+  void release() noexcept;
+
+  DatasetHeader header_;
+  // whole mapping of file and elements inside it, buffer holds the file if it couldn't be mapped
+  void* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  std::vector<uint8_t> buffer_;
+  uint8_t* data_ = nullptr;
+};
+
+// Sequential pass over elements of dataset file in chunks of about chunk_bytes, whole file is never
+// resident. READ mode reads chunks into one reused buffer, MMAP mode maps one window of the file at a
+// time with sequential read-ahead advice and unmaps it when the next chunk is requested.
+class DatasetStream {
+ public:
+  enum class Mode : uint8_t { READ, MMAP };
+
+  DatasetStream(const std::string& path, size_t chunk_bytes, Mode mode = Mode::READ);
+  DatasetStream(DatasetStream&& other) noexcept;
+  DatasetStream& operator=(DatasetStream&&) = delete;
+  DatasetStream(const DatasetStream&) = delete;
+  DatasetStream& operator=(const DatasetStream&) = delete;
+  ~DatasetStream();
+
+  [[nodiscard]] const DatasetHeader& header() const { return header_; }
+
+  // Bytes of the next whole elements, empty at the end of data
+  std::span<const uint8_t> next();
+  void rewind() { position_ = 0; }
+
+ private:
+  void unmap() noexcept;
+
+  std::string path_;
+  DatasetHeader header_;
+  Mode mode_;
+  size_t chunk_elements_ = 1;
+  uint64_t position_ = 0;
+  std::ifstream file_;
+  std::vector<uint8_t> buffer_;
+  int fd_ = -1;
+  void* window_ = nullptr;
+  size_t window_size_ = 0;
+};
+
+template <class T>
+class DatasetChunkSource : public ChunkSource<T> {
+ public:
+  DatasetChunkSource(const std::string& path, size_t chunk_size, DatasetStream::Mode mode = DatasetStream::Mode::READ)
+      : stream_(path, chunk_size * sizeof(T), mode) {
+    if (stream_.header().type != data_type_of<T>()) {
+      throw std::runtime_error(std::string("Dataset holds ") + data_type_name(stream_.header().type) + ", not " +
+                               data_type_name(data_type_of<T>()));
+    }
+  }
+
+  std::span<const T> next() override {
+    auto bytes = stream_.next();
+    return {reinterpret_cast<const T*>(bytes.data()), bytes.size() / sizeof(T)};
+  }
+
+  void rewind() override { stream_.rewind(); }
+
+  [[nodiscard]] uint64_t size() const override { return stream_.header().num_elements(); }
+
+ private:
+  DatasetStream stream_;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_DATASET_HPP_
@@ -0,0 +1,341 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/dataset/include/dataset.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PPC_DATASET_MMAP
+#endif
+
+namespace {
+
+using ppc::core::DatasetHeader;
+using ppc::core::DataType;
+
+size_t page_size() {
+#if defined(PPC_DATASET_MMAP)
+  return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+  return 4096;
+#endif
+}
+
+// Check header read from file of given size, so view of elements never leaves the file
+void validate_header(const DatasetHeader& header, uint64_t file_size, const std::string& path) {
+  if (std::memcmp(header.magic, DatasetHeader::kMagic, sizeof(header.magic)) != 0) {
+    throw std::runtime_error("Not a dataset file: " + path);
+  }
+  if (header.byte_order == DatasetHeader::kSwappedByteOrder) {
+    throw std::runtime_error("Dataset was written on a host of other byte order: " + path);
+  }
+  if (header.version != DatasetHeader::kVersion) {
+    throw std::runtime_error("Unsupported dataset version " + std::to_string(header.version) + ": " + path);
+  }
+  if (header.byte_order != DatasetHeader::kByteOrder ||
+      static_cast<uint32_t>(header.type) > static_cast<uint32_t>(DataType::FLOAT64) || header.rank == 0 ||
+      header.rank > DatasetHeader::kMaxRank) {
+    throw std::runtime_error("Corrupted dataset header: " + path);
+  }
+  // product of dimensions is checked step by step, so corrupted shape can't overflow it
+  uint64_t bytes = ppc::core::data_type_size(header.type);
+  for (uint32_t i = 0; i < header.rank; i++) {
+    if (header.shape[i] != 0 && bytes > file_size / header.shape[i]) {
+      throw std::runtime_error("Dataset file is truncated: " + path);
+    }
+    bytes *= header.shape[i];
+  }
+  if (header.data_offset < sizeof(DatasetHeader) || header.data_offset > file_size ||
+      bytes > file_size - header.data_offset) {
+    throw std::runtime_error("Dataset file is truncated: " + path);
+  }
+}
+
+}  // namespace
+
+const char* ppc::core::data_type_name(DataType type) {
+  switch (type) {
+    case DataType::INT8:
+      return "int8";
+    case DataType::UINT8:
+      return "uint8";
+    case DataType::INT16:
+      return "int16";
+    case DataType::UINT16:
+      return "uint16";
+    case DataType::INT32:
+      return "int32";
+    case DataType::UINT32:
+      return "uint32";
+    case DataType::INT64:
+      return "int64";
+    case DataType::UINT64:
+      return "uint64";
+    case DataType::FLOAT32:
+      return "float32";
+    case DataType::FLOAT64:
+      return "float64";
+  }
+  return "unknown";
+}
+
+size_t ppc::core::data_type_size(DataType type) {
+  return size_t{1} << (static_cast<uint32_t>(type) < 8 ? static_cast<uint32_t>(type) / 2
+                                                       : static_cast<uint32_t>(type) - 6);
+}
+
+uint64_t ppc::core::DatasetHeader::num_elements() const {
+  uint64_t count = 1;
+  for (uint32_t i = 0; i < std::min<uint64_t>(rank, kMaxRank); i++) {
+    count *= shape[i];
+  }
+  return count;
+}
+
+void ppc::core::write_dataset(const std::string& path, DataType type, std::span<const uint8_t> bytes,
+                              const std::vector<uint64_t>& shape, size_t alignment) {
+  auto element_size = data_type_size(type);
+  if (bytes.size() % element_size != 0) {
+    throw std::runtime_error("Dataset bytes are not whole elements of " + std::string(data_type_name(type)));
+  }
+  if (shape.size() > DatasetHeader::kMaxRank) {
+    throw std::runtime_error("Dataset shape has more than " + std::to_string(DatasetHeader::kMaxRank) +
+                             " dimensions");
+  }
+  alignment = alignment == 0 ? page_size() : alignment;
+  if ((alignment & (alignment - 1)) != 0) {
+    throw std::runtime_error("Dataset alignment has to be a power of two");
+  }
+
+  DatasetHeader header;
+  std::memcpy(header.magic, DatasetHeader::kMagic, sizeof(header.magic));
+  header.type = type;
+  header.rank = shape.empty() ? 1 : static_cast<uint32_t>(shape.size());
+  header.shape[0] = bytes.size() / element_size;
+  std::copy(shape.begin(), shape.end(), header.shape);
+  if (header.num_elements() * element_size != bytes.size()) {
+    throw std::runtime_error("Dataset shape doesn't match count of elements");
+  }
+  header.data_offset = (sizeof(DatasetHeader) + alignment - 1) / alignment * alignment;
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Can't open dataset file: " + path);
+  }
+  std::vector<char> padding(header.data_offset - sizeof(DatasetHeader), 0);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+  out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  if (!out) {
+    throw std::runtime_error("Can't write dataset file: " + path);
+  }
+}
+
+ppc::core::MappedDataset::MappedDataset(const std::string& path, Access access) {
+#if defined(PPC_DATASET_MMAP)
+  auto fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Can't open dataset file: " + path);
+  }
+  struct stat status {};
+  if (::fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(DatasetHeader)) {
+    ::close(fd);
+    throw std::runtime_error("Dataset file is truncated: " + path);
+  }
+  mapping_size_ = static_cast<size_t>(status.st_size);
+  // private writable mapping: pages are shared with page cache until a task writes to its input
+  auto* mapping = ::mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("Can't map dataset file: " + path);
+  }
+  mapping_ = mapping;
+  std::memcpy(&header_, mapping_, sizeof(header_));
+  try {
+    validate_header(header_, mapping_size_, path);
+  } catch (...) {
+    release();
+    throw;
+  }
+  data_ = static_cast<uint8_t*>(mapping_) + header_.data_offset;
+
+  int advice = access == Access::RANDOM      ? MADV_RANDOM
+               : access == Access::WILL_NEED ? MADV_WILLNEED
+                                             : MADV_SEQUENTIAL;
+  // hint is advisory, mapping stays usable if kernel rejects it
+  ::madvise(mapping_, mapping_size_, advice);
+#else
+  static_cast<void>(access);
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+    throw std::runtime_error("Can't open dataset file: " + path);
+  }
+  buffer_.resize(static_cast<size_t>(in.tellg()));
+  in.seekg(0);
+  in.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+  if (buffer_.size() < sizeof(DatasetHeader)) {
+    throw std::runtime_error("Dataset file is truncated: " + path);
+  }
+  std::memcpy(&header_, buffer_.data(), sizeof(header_));
+  validate_header(header_, buffer_.size(), path);
+  data_ = buffer_.data() + header_.data_offset;
+#endif
+}
+
+ppc::core::MappedDataset::MappedDataset(MappedDataset&& other) noexcept
+    : header_(other.header_),
+      mapping_(std::exchange(other.mapping_, nullptr)),
+      mapping_size_(std::exchange(other.mapping_size_, 0)),
+      buffer_(std::move(other.buffer_)),
+      data_(std::exchange(other.data_, nullptr)) {}
+
+ppc::core::MappedDataset& ppc::core::MappedDataset::operator=(MappedDataset&& other) noexcept {
+  if (this != &other) {
+    release();
+    header_ = other.header_;
+    mapping_ = std::exchange(other.mapping_, nullptr);
+    mapping_size_ = std::exchange(other.mapping_size_, 0);
+    buffer_ = std::move(other.buffer_);
+    data_ = std::exchange(other.data_, nullptr);
+  }
+  return *this;
+}
+
+ppc::core::MappedDataset::~MappedDataset() { release(); }
+
+void ppc::core::MappedDataset::release() noexcept {
+#if defined(PPC_DATASET_MMAP)
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mapping_size_);
+  }
+#endif
+  mapping_ = nullptr;
+  mapping_size_ = 0;
+  buffer_.clear();
+  data_ = nullptr;
+}
+
+std::vector<uint64_t> ppc::core::MappedDataset::shape() const {
+  return {header_.shape, header_.shape + header_.rank};
+}
+
+void ppc::core::MappedDataset::attach_input(TaskData& taskData) const {
+  if (size() > std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error("Dataset of " + std::to_string(size()) + " elements doesn't fit into inputs_count");
+  }
+  taskData.inputs.emplace_back(data_);
+  taskData.inputs_count.emplace_back(static_cast<uint32_t>(size()));
+  taskData.borrow_inputs = true;
+}
+
+ppc::core::DatasetStream::DatasetStream(const std::string& path, size_t chunk_bytes, Mode mode)
+    : path_(path), mode_(mode), file_(path, std::ios::binary) {
+  if (!file_) {
+    throw std::runtime_error("Can't open dataset file: " + path);
+  }
+  file_.seekg(0, std::ios::end);
+  auto file_size = static_cast<uint64_t>(file_.tellg());
+  file_.seekg(0);
+  if (file_size < sizeof(DatasetHeader) || !file_.read(reinterpret_cast<char*>(&header_), sizeof(header_))) {
+    throw std::runtime_error("Dataset file is truncated: " + path);
+  }
+  validate_header(header_, file_size, path);
+  chunk_elements_ = std::max<size_t>(chunk_bytes / data_type_size(header_.type), 1);
+
+#if defined(PPC_DATASET_MMAP)
+  fd_ = ::open(path.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    throw std::runtime_error("Can't open dataset file: " + path);
+  }
+#if defined(POSIX_FADV_SEQUENTIAL)
+  ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#else
+  mode_ = Mode::READ;
+#endif
+  if (mode_ == Mode::READ) {
+    buffer_.resize(chunk_elements_ * data_type_size(header_.type));
+  }
+}
+
+ppc::core::DatasetStream::DatasetStream(DatasetStream&& other) noexcept
+    : path_(std::move(other.path_)),
+      header_(other.header_),
+      mode_(other.mode_),
+      chunk_elements_(other.chunk_elements_),
+      position_(other.position_),
+      file_(std::move(other.file_)),
+      buffer_(std::move(other.buffer_)),
+      fd_(std::exchange(other.fd_, -1)),
+      window_(std::exchange(other.window_, nullptr)),
+      window_size_(std::exchange(other.window_size_, 0)) {}
+
+ppc::core::DatasetStream::~DatasetStream() {
+  unmap();
+#if defined(PPC_DATASET_MMAP)
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+#endif
+}
+
+void ppc::core::DatasetStream::unmap() noexcept {
+#if defined(PPC_DATASET_MMAP)
+  if (window_ != nullptr) {
+    ::munmap(window_, window_size_);
+  }
+#endif
+  window_ = nullptr;
+  window_size_ = 0;
+}
+
+std::span<const uint8_t> ppc::core::DatasetStream::next() {
+  unmap();
+  auto total = header_.num_elements();
+  if (position_ >= total) {
+    return {};
+  }
+  auto element_size = data_type_size(header_.type);
+  auto count = static_cast<size_t>(std::min<uint64_t>(chunk_elements_, total - position_));
+  auto offset = header_.data_offset + position_ * element_size;
+  auto bytes = count * element_size;
+  position_ += count;
+
+#if defined(PPC_DATASET_MMAP) && defined(POSIX_FADV_WILLNEED)
+  // start reading the following chunk from disk while this one is consumed
+  if (position_ < total) {
+    ::posix_fadvise(fd_, static_cast<off_t>(offset + bytes), static_cast<off_t>(bytes), POSIX_FADV_WILLNEED);
+  }
+#endif
+
+#if defined(PPC_DATASET_MMAP)
+  if (mode_ == Mode::MMAP) {
+    // mapping has to start at page boundary, window is widened down to it
+    auto start = offset / page_size() * page_size();
+    auto shift = static_cast<size_t>(offset - start);
+    window_size_ = shift + bytes;
+    auto* window = ::mmap(nullptr, window_size_, PROT_READ, MAP_PRIVATE, fd_, static_cast<off_t>(start));
+    if (window == MAP_FAILED) {
+      window_size_ = 0;
+      throw std::runtime_error("Can't map dataset file: " + path_);
+    }
+    window_ = window;
+    ::madvise(window_, window_size_, MADV_SEQUENTIAL);
+    return {static_cast<const uint8_t*>(window_) + shift, bytes};
+  }
+#endif
+
+  file_.clear();
+  file_.seekg(static_cast<std::streamoff>(offset));
+  if (!file_.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(bytes))) {
+    throw std::runtime_error("Can't read dataset file: " + path_);
+  }
+  return {buffer_.data(), bytes};
+}
@@ -0,0 +1,43 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "core/mpi/include/partition.hpp"
+
+TEST(partition_tests, check_even_partition) {
+  ppc::core::BlockPartition partition(12, 4);
+  EXPECT_EQ(partition.counts, std::vector<int>({3, 3, 3, 3}));
+  EXPECT_EQ(partition.displacements, std::vector<int>({0, 3, 6, 9}));
+}
+
+TEST(partition_tests, check_remainder_is_not_dropped) {
+  for (size_t total : {0, 1, 7, 101, 1000}) {
+    for (int num_parts : {1, 3, 4, 64}) {
+      ppc::core::BlockPartition partition(total, num_parts);
+      ASSERT_EQ(partition.counts.size(), static_cast<size_t>(num_parts));
+      EXPECT_EQ(static_cast<size_t>(std::accumulate(partition.counts.begin(), partition.counts.end(), 0)), total);
+      for (int part = 0; part < num_parts; part++) {
+        EXPECT_LE(partition.counts[0] - partition.counts[part], 1);
+        if (part > 0) {
+          EXPECT_EQ(partition.displacements[part], partition.displacements[part - 1] + partition.counts[part - 1]);
+        }
+      }
+    }
+  }
+}
+
+TEST(partition_tests, check_remainder_goes_to_first_blocks) {
+  ppc::core::BlockPartition partition(10, 4);
+  EXPECT_EQ(partition.counts, std::vector<int>({3, 3, 2, 2}));
+  EXPECT_EQ(partition.displacements, std::vector<int>({0, 3, 6, 8}));
+}
+
+TEST(partition_tests, check_wrong_arguments) {
+  EXPECT_THROW(ppc::core::BlockPartition(10, 0), std::invalid_argument);
+  EXPECT_THROW(ppc::core::BlockPartition(static_cast<size_t>(std::numeric_limits<int>::max()) + 1, 2),
+               std::overflow_error);
+}
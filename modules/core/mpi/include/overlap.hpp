@@ -0,0 +1,87 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_OVERLAP_HPP_
+#define MODULES_CORE_INCLUDE_OVERLAP_HPP_
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/datatype.hpp>
+#include <boost/mpi/operations.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "core/mpi/include/partition.hpp"
+
+namespace ppc::core {
+
+// Scatter root_data (read on root only) in num_chunks consecutive chunks and reduce it, overlapping
+// communication with computation: nonblocking MPI_Iscatterv of all chunks is posted up front, every
+// rank reduces its block of chunk k with chunk_reduce(block, identity) as soon as chunk k arrives,
+// while later chunks are still in flight, and posts MPI_Ireduce of that partial result right away.
+// Op is a function object Boost.MPI maps to a builtin MPI_Op (std::plus<R>, boost::mpi::maximum<R>, ...).
+// Returns reduction of whole input on root and identity on other ranks. With in_place root
+// doesn't copy its own blocks, root_data is read directly.
+template <typename T, typename R, typename ChunkReduce, typename Op>
+R scatter_reduce_overlapped(const boost::mpi::communicator& world, std::span<const T> root_data, int num_chunks,
+                            R identity, ChunkReduce&& chunk_reduce, Op op, int root = 0, bool in_place = false) {
+  static_assert(boost::mpi::is_mpi_op<Op, R>::value, "Op has to map to builtin MPI_Op");
+  auto is_root = world.rank() == root;
+  uint64_t total = is_root ? root_data.size() : 0;
+  MPI_Bcast(&total, 1, MPI_UINT64_T, root, world);
+
+  // chunks of whole input and blocks of every chunk, counts have to live until collectives complete
+  BlockPartition chunks(total, std::max(num_chunks, 1));
+  auto size = chunks.counts.size();
+  std::vector<BlockPartition> blocks;
+  blocks.reserve(size);
+  std::vector<size_t> local_offsets(size + 1, 0);
+  for (size_t k = 0; k < size; k++) {
+    blocks.emplace_back(static_cast<size_t>(chunks.counts[k]), world.size());
+    local_offsets[k + 1] = local_offsets[k] + static_cast<size_t>(blocks[k].counts[world.rank()]);
+  }
+  auto local_block = [&](size_t k) {
+    return static_cast<size_t>(chunks.displacements[k] + blocks[k].displacements[world.rank()]);
+  };
+
+  auto data_type = boost::mpi::get_mpi_datatype<T>(T());
+  auto result_type = boost::mpi::get_mpi_datatype<R>(identity);
+  auto mpi_op = boost::mpi::is_mpi_op<Op, R>::op();
+  auto keep_in_place = is_root && in_place;
+
+  std::vector<T> local_input(keep_in_place ? 0 : local_offsets[size]);
+  std::vector<MPI_Request> scatters(size, MPI_REQUEST_NULL);
+  for (size_t k = 0; k < size; k++) {
+    const T* send = is_root ? root_data.data() + chunks.displacements[k] : nullptr;
+    auto count = blocks[k].counts[world.rank()];
+    void* receive = keep_in_place ? MPI_IN_PLACE : static_cast<void*>(local_input.data() + local_offsets[k]);
+    MPI_Iscatterv(send, blocks[k].counts.data(), blocks[k].displacements.data(), data_type, receive, count, data_type,
+                  root, world, &scatters[k]);
+  }
+
+  std::vector<R> partial(size, identity);
+  std::vector<R> reduced(is_root ? size : 0, identity);
+  std::vector<MPI_Request> reductions(size, MPI_REQUEST_NULL);
+  for (size_t k = 0; k < size; k++) {
+    MPI_Wait(&scatters[k], MPI_STATUS_IGNORE);
+    auto count = local_offsets[k + 1] - local_offsets[k];
+    auto block = keep_in_place ? root_data.subspan(local_block(k), count)
+                               : std::span<const T>(local_input).subspan(local_offsets[k], count);
+    partial[k] = chunk_reduce(block, identity);
+    MPI_Ireduce(&partial[k], is_root ? &reduced[k] : nullptr, 1, result_type, mpi_op, root, world, &reductions[k]);
+  }
+  MPI_Waitall(static_cast<int>(size), reductions.data(), MPI_STATUSES_IGNORE);
+
+  auto result = identity;
+  for (const auto& value : reduced) {
+    result = op(result, value);
+  }
+  return result;
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_OVERLAP_HPP_
@@ -0,0 +1,24 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PARTITION_HPP_
+#define MODULES_CORE_INCLUDE_PARTITION_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace ppc::core {
+
+// Split of total elements into num_parts contiguous blocks whose sizes differ by at most one,
+// the first total % num_parts blocks get the extra element. Counts and displacements are ints,
+// as MPI_Scatterv and MPI_Gatherv expect them.
+struct BlockPartition {
+  BlockPartition(size_t total, int num_parts);
+
+  size_t total = 0;
+  std::vector<int> counts;
+  std::vector<int> displacements;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PARTITION_HPP_
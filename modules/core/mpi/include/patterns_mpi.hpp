@@ -0,0 +1,134 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PATTERNS_MPI_HPP_
+#define MODULES_CORE_INCLUDE_PATTERNS_MPI_HPP_
+
+#include <mpi.h>
+
+#include <boost/mpi/collectives/all_gather.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/datatype.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/mpi/include/partition.hpp"
+#include "core/mpi/include/scatter.hpp"
+#include "core/patterns/include/patterns.hpp"
+
+namespace ppc::patterns {
+
+// Distributed patterns over all ranks of world, every rank has to call them. Input is read on root
+// only and scattered in balanced blocks, every rank runs the shared memory pattern on its block with
+// Local policy (Mpi<Threads> for hybrid runs). map, inclusive_scan and stencil gather output on root,
+// out isn't touched on other ranks. Results of map_reduce and reduce are returned on all ranks.
+// Elements and outputs have to be types with builtin MPI datatype, partial results of map_reduce are
+// exchanged with Boost.MPI all_gather, so they may be any serializable type. Partial results are combined in
+// order of ranks, so op has to be associative but not commutative, as for shared memory policies.
+template <typename Local = Sequential>
+struct Mpi {
+  boost::mpi::communicator world;
+  int root = 0;
+  Local local{};
+};
+
+namespace detail {
+
+// Collect blocks of partition (local block on every rank) into root_out shifted by offset
+template <typename U>
+void gather_blocks(const boost::mpi::communicator& world, int root, std::span<const U> local,
+                   const ppc::core::BlockPartition& partition, std::span<U> root_out, size_t offset = 0) {
+  auto datatype = boost::mpi::get_mpi_datatype<U>(U());
+  auto is_root = world.rank() == root;
+  MPI_Gatherv(local.data(), static_cast<int>(local.size()), datatype, is_root ? root_out.data() + offset : nullptr,
+              partition.counts.data(), partition.displacements.data(), datatype, root, world);
+}
+
+// Fold values gathered from all ranks in order of ranks
+template <typename R, typename Op>
+R combine_ranks(const boost::mpi::communicator& world, const R& local, R identity, Op op) {
+  std::vector<R> partial;
+  boost::mpi::all_gather(world, local, partial);
+  for (auto& value : partial) {
+    identity = op(std::move(identity), std::move(value));
+  }
+  return identity;
+}
+
+}  // namespace detail
+
+template <typename Local, typename T, typename U, typename F>
+void map(const Mpi<Local>& policy, std::span<const T> in, std::span<U> out, F f) {
+  auto block = ppc::core::scatter_balanced(policy.world, in, policy.root, true);
+  std::vector<U> local(block.data.size());
+  map(policy.local, block.data, std::span<U>(local), f);
+  ppc::core::BlockPartition partition(block.total, policy.world.size());
+  detail::gather_blocks(policy.world, policy.root, std::span<const U>(local), partition, out);
+}
+
+template <typename Local, typename T, typename R, typename F, typename Op>
+R map_reduce(const Mpi<Local>& policy, std::span<const T> in, R identity, F f, Op op) {
+  auto block = ppc::core::scatter_balanced(policy.world, in, policy.root, true);
+  auto local = map_reduce(policy.local, block.data, identity, f, op);
+  return detail::combine_ranks(policy.world, local, std::move(identity), op);
+}
+
+template <typename Local, typename T, typename Op>
+T reduce(const Mpi<Local>& policy, std::span<const T> in, std::type_identity_t<T> identity, Op op) {
+  return map_reduce(policy, in, std::move(identity), [](const T& value) { return value; }, op);
+}
+
+// Every rank scans its block starting from fold of totals of blocks before it
+template <typename Local, typename T, typename Op>
+void inclusive_scan(const Mpi<Local>& policy, std::span<const T> in, std::span<T> out,
+                    std::type_identity_t<T> identity, Op op) {
+  auto block = ppc::core::scatter_balanced(policy.world, in, policy.root, true);
+  auto total = reduce(policy.local, block.data, identity, op);
+  std::vector<T> totals;
+  boost::mpi::all_gather(policy.world, total, totals);
+  auto offset = identity;
+  for (int rank = 0; rank < policy.world.rank(); rank++) {
+    offset = op(std::move(offset), totals[rank]);
+  }
+
+  std::vector<T> local(block.data.size());
+  inclusive_scan(policy.local, block.data, std::span<T>(local), offset, op);
+  ppc::core::BlockPartition partition(block.total, policy.world.size());
+  detail::gather_blocks(policy.world, policy.root, std::span<const T>(local), partition, out);
+}
+
+// Windows are split between ranks, every rank receives its block together with radius halo
+// elements on both sides in one MPI_Scatterv with overlapping send blocks
+template <typename Local, typename T, typename U, typename F>
+void stencil(const Mpi<Local>& policy, std::span<const T> in, std::span<U> out, size_t radius, F f) {
+  const auto& world = policy.world;
+  auto is_root = world.rank() == policy.root;
+  uint64_t size = is_root ? in.size() : 0;
+  MPI_Bcast(&size, 1, MPI_UINT64_T, policy.root, world);
+  if (size < 2 * radius + 1) {
+    return;
+  }
+
+  ppc::core::BlockPartition partition(size - 2 * radius, world.size());
+  auto halo_counts = partition.counts;
+  for (auto& count : halo_counts) {
+    count += count > 0 ? static_cast<int>(2 * radius) : 0;
+  }
+  auto count = partition.counts[world.rank()];
+  std::vector<T> local_in(halo_counts[world.rank()]);
+  auto datatype = boost::mpi::get_mpi_datatype<T>(T());
+  MPI_Scatterv(is_root ? in.data() : nullptr, halo_counts.data(), partition.displacements.data(), datatype,
+               local_in.data(), static_cast<int>(local_in.size()), datatype, policy.root, world);
+
+  std::vector<U> local_out(local_in.size());
+  stencil(policy.local, std::span<const T>(local_in), std::span<U>(local_out), radius, f);
+  detail::gather_blocks(policy.world, policy.root, std::span<const U>(local_out).subspan(count > 0 ? radius : 0, count),
+                        partition, out, radius);
+}
+
+}  // namespace ppc::patterns
+
+#endif  // MODULES_CORE_INCLUDE_PATTERNS_MPI_HPP_
@@ -0,0 +1,32 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PERF_MPI_HPP_
+#define MODULES_CORE_INCLUDE_PERF_MPI_HPP_
+
+#include <mpi.h>
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+
+namespace ppc::core {
+
+// Time distributed run with MPI_Wtime, align start and stop of measurement on all ranks of world
+// by barriers and gather per-rank times, so results describe the slowest rank and load imbalance.
+// Perf has to be run on every rank of world.
+inline void synchronize_ranks(PerfAttr& perfAttr, const boost::mpi::communicator& world) {
+  perfAttr.current_timer = [] { return MPI_Wtime(); };
+  perfAttr.barrier = [world] { world.barrier(); };
+  perfAttr.all_gather = [world](double value) {
+    std::vector<double> values;
+    boost::mpi::all_gather(world, value, values);
+    return values;
+  };
+  perfAttr.num_processes = world.size();
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PERF_MPI_HPP_
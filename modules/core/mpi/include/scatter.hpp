@@ -0,0 +1,84 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_SCATTER_HPP_
+#define MODULES_CORE_INCLUDE_SCATTER_HPP_
+
+#include <mpi.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/datatype.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "core/mpi/include/partition.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Block of distributed input owned by this rank. data may point into storage, which moves keep
+// valid and copies wouldn't, so the block is move-only.
+template <typename T>
+struct ScatteredBlock {
+  ScatteredBlock() = default;
+  ScatteredBlock(const ScatteredBlock&) = delete;
+  ScatteredBlock& operator=(const ScatteredBlock&) = delete;
+  ScatteredBlock(ScatteredBlock&&) noexcept = default;
+  ScatteredBlock& operator=(ScatteredBlock&&) noexcept = default;
+  ~ScatteredBlock() = default;
+
+  // received elements, stays empty on root which scattered in place
+  std::vector<T> storage;
+  std::span<const T> data;
+  // position of block in whole input and size of whole input
+  size_t offset = 0;
+  size_t total = 0;
+};
+
+// Distribute root_data (read on root only) over all ranks of world in balanced blocks with one
+// MPI_Scatterv, no element is dropped if size of input is not divisible by count of ranks.
+// With in_place root keeps its own block as a view of root_data instead of copying it,
+// so root_data has to outlive the block. T has to be a type with builtin MPI datatype.
+template <typename T>
+ScatteredBlock<T> scatter_balanced(const boost::mpi::communicator& world, std::span<const T> root_data,
+                                   int root = 0, bool in_place = false) {
+  auto is_root = world.rank() == root;
+  uint64_t total = is_root ? root_data.size() : 0;
+  MPI_Bcast(&total, 1, MPI_UINT64_T, root, world);
+
+  BlockPartition partition(total, world.size());
+  ScatteredBlock<T> block;
+  block.offset = static_cast<size_t>(partition.displacements[world.rank()]);
+  block.total = total;
+  auto count = partition.counts[world.rank()];
+  auto datatype = boost::mpi::get_mpi_datatype<T>(T());
+
+  if (is_root && in_place) {
+    MPI_Scatterv(root_data.data(), partition.counts.data(), partition.displacements.data(), datatype, MPI_IN_PLACE,
+                 count, datatype, root, world);
+    block.data = root_data.subspan(block.offset, count);
+  } else {
+    block.storage.resize(count);
+    MPI_Scatterv(is_root ? root_data.data() : nullptr, partition.counts.data(), partition.displacements.data(),
+                 datatype, block.storage.data(), count, datatype, root, world);
+    block.data = block.storage;
+  }
+  return block;
+}
+
+// Distribute input with given index of TaskData, which is filled on root only
+template <typename T>
+ScatteredBlock<T> scatter_input(const boost::mpi::communicator& world, const std::shared_ptr<TaskData>& taskData,
+                                size_t index, int root = 0, bool in_place = false) {
+  std::span<const T> root_data;
+  if (world.rank() == root) {
+    root_data = taskData->input_view<T>(index);
+  }
+  return scatter_balanced(world, root_data, root, in_place);
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_SCATTER_HPP_
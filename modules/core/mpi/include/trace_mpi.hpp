@@ -0,0 +1,53 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_TRACE_MPI_HPP_
+#define MODULES_CORE_INCLUDE_TRACE_MPI_HPP_
+
+#include <mpi.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "core/trace/include/trace.hpp"
+
+namespace ppc::core {
+
+// Gather trace events of all ranks of world into one file of PPC_TRACE written by root, so ranks
+// are processes of one timeline. Has to be called on every rank before MPI is finalized, ranks
+// don't write files of their own at exit then.
+inline void write_trace(const boost::mpi::communicator& world, int root = 0) {
+  auto& tracer = Tracer::global();
+  if (tracer.path().empty()) {
+    return;
+  }
+  tracer.set_process(world.rank());
+  auto events = tracer.events_json();
+  auto size = static_cast<int>(events.size());
+  auto is_root = world.rank() == root;
+
+  std::vector<int> sizes(is_root ? world.size() : 0);
+  MPI_Gather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, root, world);
+  std::vector<int> displacements(sizes.size(), 0);
+  if (is_root) {
+    std::exclusive_scan(sizes.begin(), sizes.end(), displacements.begin(), 0);
+  }
+  std::string all_events(is_root ? static_cast<size_t>(displacements.back() + sizes.back()) : 0, ' ');
+  MPI_Gatherv(events.data(), size, MPI_CHAR, all_events.data(), sizes.data(), displacements.data(), MPI_CHAR, root,
+              world);
+
+  if (is_root) {
+    // events of every rank are non-empty (process name at least) and are joined by commas
+    std::string joined;
+    for (size_t rank = 0; rank < sizes.size(); rank++) {
+      joined += (rank == 0 ? "" : ",\n") + all_events.substr(displacements[rank], sizes[rank]);
+    }
+    Tracer::write_events(tracer.path(), joined);
+  }
+  tracer.mark_written();
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_TRACE_MPI_HPP_
@@ -0,0 +1,25 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/mpi/include/partition.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+ppc::core::BlockPartition::BlockPartition(size_t total, int num_parts) : total(total) {
+  if (num_parts <= 0) {
+    throw std::invalid_argument("Count of blocks must be positive: " + std::to_string(num_parts));
+  }
+  if (total > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    throw std::overflow_error("Too many elements for int displacements: " + std::to_string(total));
+  }
+  auto parts = static_cast<size_t>(num_parts);
+  counts.resize(parts);
+  displacements.resize(parts);
+  size_t displacement = 0;
+  for (size_t part = 0; part < parts; part++) {
+    auto count = total / parts + (part < total % parts ? 1 : 0);
+    counts[part] = static_cast<int>(count);
+    displacements[part] = static_cast<int>(displacement);
+    displacement += count;
+  }
+}
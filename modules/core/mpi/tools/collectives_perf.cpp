@@ -0,0 +1,294 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <algorithm>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/mpi/include/perf_mpi.hpp"
+#include "core/perf/include/perf.hpp"
+#include "core/perf/include/perf_report.hpp"
+
+// Latency and bandwidth of MPI collectives, Boost.MPI against raw MPI, over message sizes and counts of ranks.
+// Run under mpirun, every power of two of ranks up to size of world is measured on a sub-communicator.
+// Message size is the block of one rank: broadcast/reduce/allreduce payload, scatter/gather piece of each rank.
+// PPC_COLLECTIVES_MAX_BYTES extends the sweep (2 MiB by default), PPC_PERF_REPORT collects records as for tasks.
+
+namespace {
+
+enum class Collective : uint8_t { BROADCAST, REDUCE, ALLREDUCE, SCATTER, GATHER };
+enum class Implementation : uint8_t { BOOST_MPI, MPI };
+
+const char* collective_name(Collective collective) {
+  switch (collective) {
+    case Collective::BROADCAST:
+      return "broadcast";
+    case Collective::REDUCE:
+      return "reduce";
+    case Collective::ALLREDUCE:
+      return "allreduce";
+    case Collective::SCATTER:
+      return "scatter";
+    case Collective::GATHER:
+      return "gather";
+  }
+  return "unknown";
+}
+
+const char* implementation_name(Implementation implementation) {
+  return implementation == Implementation::BOOST_MPI ? "boost_mpi" : "mpi";
+}
+
+// One collective call per run(), buffers are filled with rank + 1 so post_processing can check the result
+class CollectiveTask : public ppc::core::Task {
+ public:
+  CollectiveTask(std::shared_ptr<ppc::core::TaskData> taskData_, boost::mpi::communicator comm, Collective collective,
+                 Implementation implementation, int count)
+      : Task(std::move(taskData_)),
+        comm(std::move(comm)),
+        collective(collective),
+        implementation(implementation),
+        count(count) {}
+
+  bool validation() override {
+    internal_order_test();
+    return count > 0;
+  }
+
+  bool pre_processing() override {
+    internal_order_test();
+    auto blocks = static_cast<size_t>(comm.size()) * count;
+    auto value = static_cast<double>(comm.rank() + 1);
+    switch (collective) {
+      case Collective::BROADCAST:
+        send.assign(count, comm.rank() == root ? value : 0.0);
+        break;
+      case Collective::REDUCE:
+      case Collective::ALLREDUCE:
+        send.assign(count, value);
+        recv.assign(count, 0.0);
+        break;
+      case Collective::SCATTER:
+        send.assign(comm.rank() == root ? blocks : 0, 0.0);
+        for (size_t i = 0; i < send.size(); i++) {
+          send[i] = static_cast<double>(i / count + 1);
+        }
+        recv.assign(count, 0.0);
+        break;
+      case Collective::GATHER:
+        send.assign(count, value);
+        recv.assign(comm.rank() == root ? blocks : 0, 0.0);
+        break;
+    }
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    if (implementation == Implementation::BOOST_MPI) {
+      run_boost_mpi();
+    } else {
+      run_mpi();
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    auto size = static_cast<double>(comm.size());
+    auto value = static_cast<double>(comm.rank() + 1);
+    switch (collective) {
+      case Collective::BROADCAST:
+        correct = std::all_of(send.begin(), send.end(), [&](double x) { return x == root + 1; });
+        break;
+      case Collective::REDUCE:
+      case Collective::ALLREDUCE:
+        correct = (collective == Collective::REDUCE && comm.rank() != root) ||
+                  std::all_of(recv.begin(), recv.end(), [&](double x) { return x == size * (size + 1) / 2; });
+        break;
+      case Collective::SCATTER:
+        correct = std::all_of(recv.begin(), recv.end(), [&](double x) { return x == value; });
+        break;
+      case Collective::GATHER:
+        correct = true;
+        for (size_t i = 0; i < recv.size(); i++) {
+          correct = correct && recv[i] == static_cast<double>(i / count + 1);
+        }
+        break;
+    }
+    return true;
+  }
+
+  bool is_correct() const { return correct; }
+
+ private:
+  void run_boost_mpi() {
+    switch (collective) {
+      case Collective::BROADCAST:
+        boost::mpi::broadcast(comm, send.data(), count, root);
+        break;
+      case Collective::REDUCE:
+        if (comm.rank() == root) {
+          boost::mpi::reduce(comm, send.data(), count, recv.data(), std::plus<double>(), root);
+        } else {
+          boost::mpi::reduce(comm, send.data(), count, std::plus<double>(), root);
+        }
+        break;
+      case Collective::ALLREDUCE:
+        boost::mpi::all_reduce(comm, send.data(), count, recv.data(), std::plus<double>());
+        break;
+      case Collective::SCATTER:
+        boost::mpi::scatter(comm, send.data(), recv.data(), count, root);
+        break;
+      case Collective::GATHER:
+        if (comm.rank() == root) {
+          boost::mpi::gather(comm, send.data(), count, recv.data(), root);
+        } else {
+          boost::mpi::gather(comm, send.data(), count, root);
+        }
+        break;
+    }
+  }
+
+  void run_mpi() {
+    switch (collective) {
+      case Collective::BROADCAST:
+        MPI_Bcast(send.data(), count, MPI_DOUBLE, root, comm);
+        break;
+      case Collective::REDUCE:
+        MPI_Reduce(send.data(), recv.data(), count, MPI_DOUBLE, MPI_SUM, root, comm);
+        break;
+      case Collective::ALLREDUCE:
+        MPI_Allreduce(send.data(), recv.data(), count, MPI_DOUBLE, MPI_SUM, comm);
+        break;
+      case Collective::SCATTER:
+        MPI_Scatter(send.data(), count, MPI_DOUBLE, recv.data(), count, MPI_DOUBLE, root, comm);
+        break;
+      case Collective::GATHER:
+        MPI_Gather(send.data(), count, MPI_DOUBLE, recv.data(), count, MPI_DOUBLE, root, comm);
+        break;
+    }
+  }
+
+  static constexpr int root = 0;
+  boost::mpi::communicator comm;
+  Collective collective;
+  Implementation implementation;
+  int count;
+  std::vector<double> send;
+  std::vector<double> recv;
+  bool correct = false;
+};
+
+// Time of one call, barrier-aligned over all ranks of communicator (in seconds)
+double measure(const boost::mpi::communicator& comm, Collective collective, Implementation implementation,
+               size_t bytes) {
+  auto count = static_cast<int>(bytes / sizeof(double));
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  auto task = std::make_shared<CollectiveTask>(taskData, comm, collective, implementation, count);
+
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  // about 16 MiB per rank are moved for every point, so small messages get enough calls to be timed
+  perfAttr->num_running = std::clamp<uint64_t>((size_t{1} << 24) / bytes, 5, 1000);
+  perfAttr->num_warmup = 2;
+  perfAttr->task_id = std::string("collectives/") + collective_name(collective) + "/" + std::to_string(bytes);
+  perfAttr->backend = implementation_name(implementation);
+  ppc::core::synchronize_ranks(*perfAttr, comm);
+
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perfAnalyzer(task);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  // task has no inputs in TaskData, so size of measurement is given by message
+  perfResults->input_size = bytes;
+  EXPECT_TRUE(task->is_correct()) << collective_name(collective) << " of " << implementation_name(implementation)
+                                  << " on " << comm.size() << " ranks, " << bytes << " bytes";
+
+  auto report_path = std::getenv("PPC_PERF_REPORT");
+  if (report_path != nullptr && comm.rank() == 0) {
+    ppc::core::write_perf_records(report_path, ppc::core::make_perf_records(*perfResults));
+  }
+  return perfResults->time_sec / static_cast<double>(perfAttr->num_running);
+}
+
+std::vector<size_t> message_sizes() {
+  size_t max_bytes = size_t{1} << 21;
+  if (auto value = std::getenv("PPC_COLLECTIVES_MAX_BYTES")) {
+    max_bytes = std::stoull(value);
+  }
+  std::vector<size_t> sizes;
+  for (size_t bytes = sizeof(double); bytes <= max_bytes; bytes *= 4) {
+    sizes.push_back(bytes);
+  }
+  return sizes;
+}
+
+std::vector<int> rank_counts(int world_size) {
+  std::vector<int> counts;
+  for (int ranks = 1; ranks < world_size; ranks *= 2) {
+    counts.push_back(ranks);
+  }
+  counts.push_back(world_size);
+  return counts;
+}
+
+// Print latency (us) and bandwidth (MB/s, message size over latency) of both implementations side by side
+void sweep(Collective collective) {
+  boost::mpi::communicator world;
+  if (world.rank() == 0) {
+    std::cout << collective_name(collective) << std::endl
+              << std::setw(6) << "ranks" << std::setw(10) << "bytes" << std::setw(16) << "boost_mpi (us)"
+              << std::setw(12) << "mpi (us)" << std::setw(18) << "boost_mpi (MB/s)" << std::setw(12) << "mpi (MB/s)"
+              << std::endl;
+  }
+  for (auto ranks : rank_counts(world.size())) {
+    auto member = world.rank() < ranks;
+    auto comm = world.split(member ? 0 : 1);
+    if (member) {
+      for (auto bytes : message_sizes()) {
+        auto boost_time = measure(comm, collective, Implementation::BOOST_MPI, bytes);
+        auto mpi_time = measure(comm, collective, Implementation::MPI, bytes);
+        if (world.rank() == 0) {
+          auto bandwidth = [&](double time) { return time > 0.0 ? static_cast<double>(bytes) / time * 1e-6 : 0.0; };
+          std::cout << std::fixed << std::setprecision(2) << std::setw(6) << ranks << std::setw(10) << bytes
+                    << std::setw(16) << boost_time * 1e6 << std::setw(12) << mpi_time * 1e6 << std::setw(18)
+                    << bandwidth(boost_time) << std::setw(12) << bandwidth(mpi_time) << std::endl;
+        }
+      }
+    }
+    world.barrier();
+  }
+}
+
+}  // namespace
+
+TEST(mpi_collectives_perf, broadcast) { sweep(Collective::BROADCAST); }
+
+TEST(mpi_collectives_perf, reduce) { sweep(Collective::REDUCE); }
+
+TEST(mpi_collectives_perf, allreduce) { sweep(Collective::ALLREDUCE); }
+
+TEST(mpi_collectives_perf, scatter) { sweep(Collective::SCATTER); }
+
+TEST(mpi_collectives_perf, gather) { sweep(Collective::GATHER); }
+
+int main(int argc, char** argv) {
+  boost::mpi::environment env(argc, argv);
+  boost::mpi::communicator world;
+  ::testing::InitGoogleTest(&argc, argv);
+  ::testing::TestEventListeners& listeners = ::testing::UnitTest::GetInstance()->listeners();
+  if (world.rank() != 0) {
+    delete listeners.Release(listeners.default_result_printer());
+  }
+  return RUN_ALL_TESTS();
+}
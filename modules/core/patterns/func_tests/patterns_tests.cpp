@@ -0,0 +1,122 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <numeric>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "core/patterns/include/patterns.hpp"
+
+namespace {
+
+std::vector<int> iota_values(size_t size) {
+  std::vector<int> values(size);
+  std::iota(values.begin(), values.end(), 1);
+  return values;
+}
+
+// Run check with sequential policy and thread policies of several sizes
+template <typename Check>
+void for_each_policy(Check check) {
+  check(ppc::patterns::Sequential{});
+  for (int num_threads : {1, 2, 3, 8}) {
+    SCOPED_TRACE(std::to_string(num_threads) + " threads");
+    check(ppc::patterns::Threads{num_threads});
+  }
+}
+
+const std::vector<size_t> sizes = {0, 1, 2, 3, 7, 100, 1001};
+
+}  // namespace
+
+TEST(patterns_tests, check_map) {
+  for_each_policy([](const auto& policy) {
+    for (auto size : sizes) {
+      auto values = iota_values(size);
+      std::vector<long> out(size, 0);
+      ppc::patterns::map(policy, std::span<const int>(values), std::span<long>(out),
+                         [](int value) { return 2L * value; });
+      for (size_t i = 0; i < size; i++) {
+        ASSERT_EQ(out[i], 2L * values[i]);
+      }
+    }
+  });
+}
+
+TEST(patterns_tests, check_map_in_place) {
+  for_each_policy([](const auto& policy) {
+    auto values = iota_values(1000);
+    ppc::patterns::map(policy, std::span<const int>(values), std::span<int>(values), [](int value) { return -value; });
+    EXPECT_EQ(values.front(), -1);
+    EXPECT_EQ(values.back(), -1000);
+  });
+}
+
+TEST(patterns_tests, check_reduce_and_map_reduce) {
+  for_each_policy([](const auto& policy) {
+    for (auto size : sizes) {
+      auto values = iota_values(size);
+      std::span<const int> view(values);
+      auto expected = static_cast<long>(size) * static_cast<long>(size + 1) / 2;
+      EXPECT_EQ(ppc::patterns::reduce(policy, view, 0, std::plus<>()), static_cast<int>(expected));
+      EXPECT_EQ(ppc::patterns::map_reduce(policy, view, 0L, [](int value) { return long{value}; }, std::plus<>()),
+                expected);
+    }
+  });
+}
+
+TEST(patterns_tests, check_non_commutative_op_keeps_order) {
+  // concatenation is associative only, any reordering of chunks would change result
+  std::string letters = "abcdefghijklmnopqrstuvwxyz";
+  std::span<const char> view(letters.data(), letters.size());
+  auto to_string = [](char letter) { return std::string(1, letter); };
+  for_each_policy([&](const auto& policy) {
+    EXPECT_EQ(ppc::patterns::map_reduce(policy, view, std::string(), to_string, std::plus<>()), letters);
+
+    std::vector<std::string> words(letters.size());
+    ppc::patterns::map(policy, view, std::span<std::string>(words), to_string);
+    std::vector<std::string> prefixes(words.size());
+    ppc::patterns::inclusive_scan(policy, std::span<const std::string>(words), std::span<std::string>(prefixes),
+                                  std::string(), std::plus<>());
+    for (size_t i = 0; i < letters.size(); i++) {
+      ASSERT_EQ(prefixes[i], letters.substr(0, i + 1));
+    }
+  });
+}
+
+TEST(patterns_tests, check_inclusive_scan) {
+  for_each_policy([](const auto& policy) {
+    for (auto size : sizes) {
+      auto values = iota_values(size);
+      std::vector<int> expected(size);
+      std::inclusive_scan(values.begin(), values.end(), expected.begin());
+
+      std::vector<int> out(size, 0);
+      ppc::patterns::inclusive_scan(policy, std::span<const int>(values), std::span<int>(out), 0, std::plus<>());
+      EXPECT_EQ(out, expected);
+      ppc::patterns::inclusive_scan(policy, std::span<const int>(values), std::span<int>(values), 0, std::plus<>());
+      EXPECT_EQ(values, expected);
+    }
+  });
+}
+
+TEST(patterns_tests, check_stencil) {
+  auto window_sum = [](std::span<const int> window) { return std::accumulate(window.begin(), window.end(), 0); };
+  for_each_policy([&](const auto& policy) {
+    for (auto size : sizes) {
+      for (size_t radius : {0, 1, 3}) {
+        auto values = iota_values(size);
+        std::vector<int> out(size, -1);
+        ppc::patterns::stencil(policy, std::span<const int>(values), std::span<int>(out), radius, window_sum);
+        for (size_t i = 0; i < size; i++) {
+          auto inner = i >= radius && i + radius < size;
+          // window of consecutive values is centered at values[i]
+          ASSERT_EQ(out[i], inner ? values[i] * static_cast<int>(2 * radius + 1) : -1)
+              << "size " << size << ", radius " << radius << ", index " << i;
+        }
+      }
+    }
+  });
+}
@@ -0,0 +1,160 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PATTERNS_HPP_
+#define MODULES_CORE_INCLUDE_PATTERNS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/threading/include/reducer.hpp"
+#include "core/threading/include/thread_pool.hpp"
+#include "core/threading/include/threading.hpp"
+#include "core/trace/include/trace.hpp"
+
+// Parallel patterns written once and run on any backend selected by execution policy:
+//   ppc::patterns::reduce(ppc::patterns::Threads{}, values, 0, std::plus<>());
+// Sequential and Threads (persistent std::thread pool) policies are defined here, OpenMP and Tbb in
+// patterns_omp.hpp and patterns_tbb.hpp, Mpi in core/mpi/include/patterns_mpi.hpp.
+//
+// A shared memory policy provides concurrency(policy) and for_chunks(policy, num_chunks, body), which calls
+// body(chunk) for every chunk in parallel. Patterns split input into that many contiguous chunks and combine
+// partial results in order of chunks, so operations have to be associative but not commutative, and
+// results don't depend on backend or scheduling.
+
+namespace ppc::patterns {
+
+struct Sequential {};
+
+inline int concurrency(const Sequential& /*policy*/) { return 1; }
+
+template <typename Body>
+void for_chunks(const Sequential& /*policy*/, size_t num_chunks, Body&& body) {
+  for (size_t chunk = 0; chunk < num_chunks; chunk++) {
+    body(chunk);
+  }
+}
+
+// Workers of ppc::core::ThreadPool::global(), calling thread takes part
+struct Threads {
+  int num_threads = ppc::core::get_num_threads();
+};
+
+inline int concurrency(const Threads& policy) { return policy.num_threads; }
+
+template <typename Body>
+void for_chunks(const Threads& policy, size_t num_chunks, Body&& body) {
+  ppc::core::ThreadPool::global().parallel_for(
+      size_t{0}, num_chunks,
+      [&](size_t first, size_t last) {
+        for (auto chunk = first; chunk < last; chunk++) {
+          body(chunk);
+        }
+      },
+      policy.num_threads);
+}
+
+namespace detail {
+
+// One chunk per thread, but no empty chunks
+template <typename Policy>
+size_t num_chunks(const Policy& policy, size_t size) {
+  return std::clamp<size_t>(static_cast<size_t>(std::max(concurrency(policy), 1)), 1, std::max<size_t>(size, 1));
+}
+
+inline size_t chunk_offset(size_t chunk, size_t size, size_t num_chunks) {
+  return chunk * (size / num_chunks) + std::min(chunk, size % num_chunks);
+}
+
+// Call body(chunk, begin, end) for balanced chunks of [0, size)
+template <typename Policy, typename Body>
+void for_ranges(const Policy& policy, size_t size, size_t num_chunks, Body&& body) {
+  for_chunks(policy, num_chunks, [&](size_t chunk) {
+    ppc::core::TraceSpan span("chunk", "patterns");
+    body(chunk, chunk_offset(chunk, size, num_chunks), chunk_offset(chunk + 1, size, num_chunks));
+  });
+}
+
+}  // namespace detail
+
+// out[i] = f(in[i]), out has to hold in.size() values and may be the same memory as in
+template <typename Policy, typename T, typename U, typename F>
+void map(const Policy& policy, std::span<const T> in, std::span<U> out, F f) {
+  detail::for_ranges(policy, in.size(), detail::num_chunks(policy, in.size()), [&](size_t, size_t begin, size_t end) {
+    for (auto i = begin; i < end; i++) {
+      out[i] = f(in[i]);
+    }
+  });
+}
+
+// op(...op(op(identity, f(in[0])), f(in[1]))..., f(in[n - 1])) up to reassociation, op has to be associative
+template <typename Policy, typename T, typename R, typename F, typename Op>
+R map_reduce(const Policy& policy, std::span<const T> in, R identity, F f, Op op) {
+  auto num_chunks = detail::num_chunks(policy, in.size());
+  ppc::core::PaddedReducer<R, Op> partial(num_chunks, identity, op);
+  detail::for_ranges(policy, in.size(), num_chunks, [&](size_t chunk, size_t begin, size_t end) {
+    auto result = identity;
+    for (auto i = begin; i < end; i++) {
+      result = op(std::move(result), f(in[i]));
+    }
+    partial.local(chunk) = std::move(result);
+  });
+  return partial.result();
+}
+
+template <typename Policy, typename T, typename Op>
+T reduce(const Policy& policy, std::span<const T> in, std::type_identity_t<T> identity, Op op) {
+  return map_reduce(policy, in, std::move(identity), [](const T& value) { return value; }, op);
+}
+
+// out[i] = op(...op(op(identity, in[0]), in[1])..., in[i]), out may be the same memory as in.
+// Chunks are folded first, then every chunk is scanned starting from fold of the chunks before it.
+template <typename Policy, typename T, typename Op>
+void inclusive_scan(const Policy& policy, std::span<const T> in, std::span<T> out, std::type_identity_t<T> identity,
+                    Op op) {
+  auto num_chunks = detail::num_chunks(policy, in.size());
+  std::vector<T> offsets(num_chunks, identity);
+  if (num_chunks > 1) {
+    ppc::core::PaddedReducer<T, Op> totals(num_chunks, identity, op);
+    detail::for_ranges(policy, in.size(), num_chunks, [&](size_t chunk, size_t begin, size_t end) {
+      auto total = identity;
+      for (auto i = begin; i < end; i++) {
+        total = op(std::move(total), in[i]);
+      }
+      totals.local(chunk) = std::move(total);
+    });
+    for (size_t chunk = 1; chunk < num_chunks; chunk++) {
+      offsets[chunk] = op(offsets[chunk - 1], totals.local(chunk - 1));
+    }
+  }
+  detail::for_ranges(policy, in.size(), num_chunks, [&](size_t chunk, size_t begin, size_t end) {
+    auto running = offsets[chunk];
+    for (auto i = begin; i < end; i++) {
+      running = op(std::move(running), in[i]);
+      out[i] = running;
+    }
+  });
+}
+
+// out[i] = f(in.subspan(i - radius, 2 * radius + 1)) for every i with full window, border values of out
+// (first and last radius ones) are left untouched. out must not be the same memory as in.
+template <typename Policy, typename T, typename U, typename F>
+void stencil(const Policy& policy, std::span<const T> in, std::span<U> out, size_t radius, F f) {
+  auto window = 2 * radius + 1;
+  if (in.size() < window) {
+    return;
+  }
+  auto size = in.size() - 2 * radius;
+  detail::for_ranges(policy, size, detail::num_chunks(policy, size), [&](size_t, size_t begin, size_t end) {
+    for (auto i = begin; i < end; i++) {
+      out[i + radius] = f(in.subspan(i, window));
+    }
+  });
+}
+
+}  // namespace ppc::patterns
+
+#endif  // MODULES_CORE_INCLUDE_PATTERNS_HPP_
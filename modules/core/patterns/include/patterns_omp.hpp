@@ -0,0 +1,33 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PATTERNS_OMP_HPP_
+#define MODULES_CORE_INCLUDE_PATTERNS_OMP_HPP_
+
+#include <omp.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/patterns/include/patterns.hpp"
+
+namespace ppc::patterns {
+
+// Chunks are spread over threads of OpenMP parallel region, body must not throw
+struct OpenMP {
+  int num_threads = omp_get_max_threads();
+};
+
+inline int concurrency(const OpenMP& policy) { return policy.num_threads; }
+
+template <typename Body>
+void for_chunks(const OpenMP& policy, size_t num_chunks, Body&& body) {
+  auto count = static_cast<int64_t>(num_chunks);
+#pragma omp parallel for num_threads(policy.num_threads) schedule(static, 1)
+  for (int64_t chunk = 0; chunk < count; chunk++) {
+    body(static_cast<size_t>(chunk));
+  }
+}
+
+}  // namespace ppc::patterns
+
+#endif  // MODULES_CORE_INCLUDE_PATTERNS_OMP_HPP_
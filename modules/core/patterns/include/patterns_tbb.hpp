@@ -0,0 +1,40 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PATTERNS_TBB_HPP_
+#define MODULES_CORE_INCLUDE_PATTERNS_TBB_HPP_
+
+#include <tbb/tbb.h>
+
+#include <cstddef>
+
+#include "core/patterns/include/patterns.hpp"
+
+namespace ppc::patterns {
+
+inline int tbb_max_threads() {
+  return static_cast<int>(
+      oneapi::tbb::global_control::active_value(oneapi::tbb::global_control::max_allowed_parallelism));
+}
+
+// Chunks are oneTBB tasks, count of threads defaults to limit set by tbb::global_control.
+// Smaller counts run in a separate task_arena of that size.
+struct Tbb {
+  int num_threads = tbb_max_threads();
+};
+
+inline int concurrency(const Tbb& policy) { return policy.num_threads; }
+
+template <typename Body>
+void for_chunks(const Tbb& policy, size_t num_chunks, Body&& body) {
+  auto run = [&] { oneapi::tbb::parallel_for(size_t{0}, num_chunks, [&](size_t chunk) { body(chunk); }); };
+  if (policy.num_threads >= tbb_max_threads()) {
+    run();
+  } else {
+    oneapi::tbb::task_arena arena(policy.num_threads);
+    arena.execute(run);
+  }
+}
+
+}  // namespace ppc::patterns
+
+#endif  // MODULES_CORE_INCLUDE_PATTERNS_TBB_HPP_
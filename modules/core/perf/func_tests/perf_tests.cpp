@@ -1,10 +1,18 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "core/perf/func_tests/test_task.hpp"
 #include "core/perf/include/perf.hpp"
+#include "core/perf/include/perf_baseline.hpp"
+#include "core/perf/include/perf_report.hpp"
 
 TEST(perf_tests, check_perf_pipeline) {
   // Create data
@@ -155,3 +163,633 @@ TEST(perf_tests, check_perf_task_float) {
   ASSERT_LE(perfResults->time_sec, 10.0);
   EXPECT_EQ(out[0], in.size());
 }
+
+TEST(perf_tests, check_perf_samples_and_warmup) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes with timer which advances by one second on every call
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->num_warmup = 3;
+  uint64_t timer_calls = 0;
+  perfAttr->current_timer = [&] { return static_cast<double>(timer_calls++); };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  // iteration is timed once, phase breakdown adds three reads inside it (in warm-up runs too)
+  ASSERT_EQ(perfResults->samples.size(), perfAttr->num_running);
+  EXPECT_EQ(timer_calls, 3 * perfAttr->num_warmup + 4 * perfAttr->num_running + 1);
+  EXPECT_DOUBLE_EQ(perfResults->time_sec, 40.0);
+  EXPECT_DOUBLE_EQ(perfResults->statistics.median, 4.0);
+  EXPECT_DOUBLE_EQ(perfResults->statistics.stddev, 0.0);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_counters) {
+  // Create data
+  std::vector<uint32_t> in(20000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  perfAttr->collect_counters = true;
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer, counters may be forbidden in containers, then run is just timed
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  const auto &counters = perfResults->counters;
+  ASSERT_EQ(perfResults->samples.size(), perfAttr->num_running);
+  if (!counters.any_available()) {
+    EXPECT_TRUE(counters.samples.empty());
+    GTEST_SKIP() << "Hardware counters are not available";
+  }
+  ASSERT_EQ(counters.samples.size(), perfAttr->num_running);
+  if (counters.available[ppc::core::PerfCounterResults::INSTRUCTIONS]) {
+    EXPECT_GT(counters.total[ppc::core::PerfCounterResults::INSTRUCTIONS], in.size());
+  }
+}
+
+TEST(perf_tests, check_perf_counter_metrics) {
+  ppc::core::PerfCounterResults counters;
+  EXPECT_FALSE(counters.any_available());
+  EXPECT_DOUBLE_EQ(counters.ipc(), 0.0);
+  counters.available[ppc::core::PerfCounterResults::CYCLES] = true;
+  counters.total = {1000, 2500, 20, 5, 80};
+  EXPECT_TRUE(counters.any_available());
+  EXPECT_DOUBLE_EQ(counters.ipc(), 2.5);
+  EXPECT_DOUBLE_EQ(counters.cache_miss_rate(), 0.25);
+  EXPECT_DOUBLE_EQ(counters.branch_mpki(), 2.0);
+  EXPECT_STREQ(ppc::core::PerfCounterResults::counter_name(ppc::core::PerfCounterResults::LLC_REFERENCES),
+               "llc_references");
+}
+
+TEST(perf_tests, check_statistics) {
+  std::vector<double> samples = {5.0, 1.0, 4.0, 2.0, 3.0};
+
+  auto stat = ppc::core::compute_statistics(samples, 3.5);
+
+  EXPECT_DOUBLE_EQ(stat.min, 1.0);
+  EXPECT_DOUBLE_EQ(stat.max, 5.0);
+  EXPECT_DOUBLE_EQ(stat.median, 3.0);
+  EXPECT_DOUBLE_EQ(stat.mean, 3.0);
+  EXPECT_NEAR(stat.stddev, 1.5811388, 1e-6);
+  EXPECT_NEAR(stat.p95, 4.8, 1e-12);
+  EXPECT_NEAR(stat.p99, 4.96, 1e-12);
+  EXPECT_EQ(stat.num_outliers, 0U);
+}
+
+TEST(perf_tests, check_statistics_outlier_rejection) {
+  std::vector<double> samples = {1.0, 1.1, 0.9, 1.0, 1.05, 0.95, 100.0};
+
+  auto stat = ppc::core::compute_statistics(samples, 3.5);
+
+  EXPECT_EQ(stat.num_outliers, 1U);
+  EXPECT_DOUBLE_EQ(stat.max, 100.0);
+  EXPECT_NEAR(stat.mean, 1.0, 1e-12);
+  EXPECT_LT(stat.stddev, 0.1);
+}
+
+TEST(perf_tests, check_statistics_empty) {
+  auto stat = ppc::core::compute_statistics({}, 3.5);
+
+  EXPECT_DOUBLE_EQ(stat.mean, 0.0);
+  EXPECT_EQ(stat.num_outliers, 0U);
+}
+
+TEST(perf_tests, check_perf_pipeline_phases) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes with timer which advances by one second on every call
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->num_warmup = 2;
+  uint64_t timer_calls = 0;
+  perfAttr->current_timer = [&] { return static_cast<double>(timer_calls++); };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  for (const auto &phase : perfResults->phases) {
+    ASSERT_EQ(phase.samples.size(), perfAttr->num_running);
+    EXPECT_DOUBLE_EQ(phase.time_sec, 10.0);
+    EXPECT_DOUBLE_EQ(phase.statistics.mean, 1.0);
+  }
+  EXPECT_STREQ(ppc::core::PerfResults::phase_name(ppc::core::PerfResults::PRE_PROCESSING), "pre_processing");
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_scaling) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out_seq(1, 0);
+  std::vector<uint32_t> out_par(1, 0);
+
+  // Create TaskData
+  auto taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskDataSeq->inputs_count.emplace_back(in.size());
+  taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(out_seq.data()));
+  taskDataSeq->outputs_count.emplace_back(out_seq.size());
+  auto taskDataPar = std::make_shared<ppc::core::TaskData>(*taskDataSeq);
+  taskDataPar->outputs[0] = reinterpret_cast<uint8_t *>(out_par.data());
+
+  // Create Task
+  auto testTaskSeq = std::make_shared<ppc::test::TestTask<uint32_t>>(taskDataSeq);
+  auto testTaskPar = std::make_shared<ppc::test::TestTask<uint32_t>>(taskDataPar);
+
+  // Create Perf attributes with timer which advances by one second on every call
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  perfAttr->thread_counts = {1, 2, 4};
+  std::vector<int> switched_thread_counts;
+  perfAttr->set_num_threads = [&](int num_threads) { switched_thread_counts.push_back(num_threads); };
+  uint64_t timer_calls = 0;
+  perfAttr->current_timer = [&] { return static_cast<double>(timer_calls++); };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTaskPar);
+  perfAnalyzer.scaling_run(perfAttr, perfResults, testTaskSeq);
+
+  EXPECT_EQ(perfResults->type_of_running, ppc::core::PerfResults::TypeOfRunning::SCALING);
+  EXPECT_EQ(switched_thread_counts, perfAttr->thread_counts);
+  ASSERT_EQ(perfResults->scaling.size(), perfAttr->thread_counts.size());
+  for (size_t i = 0; i < perfResults->scaling.size(); i++) {
+    const auto &point = perfResults->scaling[i];
+    EXPECT_EQ(point.num_threads, perfAttr->thread_counts[i]);
+    EXPECT_DOUBLE_EQ(point.speedup, 1.0);
+    EXPECT_DOUBLE_EQ(point.efficiency, 1.0 / point.num_threads);
+  }
+  EXPECT_EQ(out_seq[0], in.size());
+  EXPECT_EQ(out_par[0], in.size());
+}
+
+TEST(perf_tests, check_perf_scaling_against_one_thread) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes with timer which advances by one second on every call
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  perfAttr->thread_counts = {2, 4};
+  std::vector<int> switched_thread_counts;
+  perfAttr->set_num_threads = [&](int num_threads) { switched_thread_counts.push_back(num_threads); };
+  uint64_t timer_calls = 0;
+  perfAttr->current_timer = [&] { return static_cast<double>(timer_calls++); };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.scaling_run(perfAttr, perfResults);
+
+  EXPECT_EQ(switched_thread_counts, std::vector<int>({1, 2, 4}));
+  ASSERT_EQ(perfResults->scaling.size(), perfAttr->thread_counts.size());
+  for (const auto &point : perfResults->scaling) {
+    EXPECT_DOUBLE_EQ(point.speedup, 1.0);
+  }
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_task_id_from_path) {
+  auto [task_id, backend] = ppc::core::task_id_from_path("/home/ppc/tasks/omp/example/perf_tests/main.cpp");
+  EXPECT_EQ(task_id, "example");
+  EXPECT_EQ(backend, "omp");
+
+  auto [unknown_task_id, unknown_backend] = ppc::core::task_id_from_path("main.cpp");
+  EXPECT_EQ(unknown_task_id, "unknown");
+}
+
+TEST(perf_tests, check_perf_records) {
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  perfResults->type_of_running = ppc::core::PerfResults::TypeOfRunning::PIPELINE;
+  perfResults->task_id = "example";
+  perfResults->backend = "seq";
+  perfResults->samples = {1.0, 2.0};
+  perfResults->phases[ppc::core::PerfResults::RUN].samples = {0.5, 1.5};
+
+  auto records = ppc::core::make_perf_records(*perfResults);
+
+  ASSERT_EQ(records.size(), 1U + ppc::core::PerfResults::NUM_PHASES);
+  EXPECT_EQ(records[0].phase, "total");
+  EXPECT_EQ(records[0].type_of_running, "pipeline");
+  EXPECT_EQ(records[0].samples, perfResults->samples);
+  EXPECT_EQ(records[1 + ppc::core::PerfResults::RUN].phase, "run");
+  EXPECT_EQ(records[1 + ppc::core::PerfResults::RUN].samples, perfResults->phases[ppc::core::PerfResults::RUN].samples);
+  EXPECT_FALSE(records[0].environment.compiler.empty());
+}
+
+TEST(perf_tests, check_perf_report_files) {
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  perfResults->type_of_running = ppc::core::PerfResults::TypeOfRunning::TASK_RUN;
+  perfResults->task_id = "example";
+  perfResults->backend = "seq";
+  perfResults->samples = {1.0, 2.0};
+  auto records = ppc::core::make_perf_records(*perfResults);
+
+  auto csv_path = (std::filesystem::temp_directory_path() / "ppc_perf_report_test.csv").string();
+  auto json_path = (std::filesystem::temp_directory_path() / "ppc_perf_report_test.json").string();
+  std::filesystem::remove(csv_path);
+  std::filesystem::remove(json_path);
+  ppc::core::write_perf_records(csv_path, records);
+  ppc::core::write_perf_records(csv_path, records);
+  ppc::core::write_perf_records(json_path, records);
+
+  std::vector<std::string> csv_lines;
+  std::ifstream csv(csv_path);
+  for (std::string line; std::getline(csv, line);) {
+    csv_lines.push_back(line);
+  }
+  ASSERT_EQ(csv_lines.size(), 3U);
+  EXPECT_EQ(csv_lines[0].rfind("task_id,backend,type_of_running,phase", 0), 0U);
+  EXPECT_EQ(csv_lines[1].rfind("example,seq,task_run,total,1,1,0", 0), 0U);
+  EXPECT_NE(csv_lines[1].find(",1;2,"), std::string::npos);
+
+  std::ifstream json(json_path);
+  std::string json_line;
+  std::getline(json, json_line);
+  EXPECT_EQ(json_line.rfind("{\"task_id\":\"example\",\"backend\":\"seq\"", 0), 0U);
+  EXPECT_NE(json_line.find("\"samples\":[1,2]"), std::string::npos);
+
+  std::filesystem::remove(csv_path);
+  std::filesystem::remove(json_path);
+}
+
+TEST(perf_tests, check_perf_report_round_trip) {
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  perfResults->type_of_running = ppc::core::PerfResults::TypeOfRunning::PIPELINE;
+  perfResults->task_id = "example, \"quoted\"";
+  perfResults->backend = "omp";
+  perfResults->num_threads = 4;
+  perfResults->samples = {0.5, 0.25, 0.125};
+  perfResults->statistics = ppc::core::compute_statistics(perfResults->samples, 3.5);
+  auto records = ppc::core::make_perf_records(*perfResults);
+
+  for (const auto* extension : {".csv", ".json"}) {
+    auto path = (std::filesystem::temp_directory_path() / "ppc_perf_round_trip").string() + extension;
+    std::filesystem::remove(path);
+    ppc::core::write_perf_records(path, records);
+    auto read = ppc::core::read_perf_records(path);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(read.size(), records.size());
+    EXPECT_EQ(read[0].task_id, records[0].task_id);
+    EXPECT_EQ(read[0].backend, "omp");
+    EXPECT_EQ(read[0].phase, "total");
+    EXPECT_EQ(read[0].num_threads, 4);
+    EXPECT_EQ(read[0].samples, records[0].samples);
+    EXPECT_DOUBLE_EQ(read[0].statistics.median, records[0].statistics.median);
+    EXPECT_EQ(read[0].environment.compiler, records[0].environment.compiler);
+    EXPECT_EQ(read[1].phase, "validation");
+  }
+}
+
+TEST(perf_tests, check_mann_whitney_p_value) {
+  std::vector<double> baseline = {1.0, 1.1, 0.9, 1.05, 0.95, 1.0, 1.02, 0.98};
+  std::vector<double> slower = {1.5, 1.6, 1.4, 1.55, 1.45, 1.5, 1.52, 1.48};
+  EXPECT_LT(ppc::core::mann_whitney_p_value(baseline, slower), 0.001);
+  EXPECT_GT(ppc::core::mann_whitney_p_value(slower, baseline), 0.999);
+  EXPECT_NEAR(ppc::core::mann_whitney_p_value(baseline, baseline), 0.5, 0.1);
+  EXPECT_DOUBLE_EQ(ppc::core::mann_whitney_p_value({1.0, 1.0}, {1.0, 1.0}), 1.0);
+  EXPECT_DOUBLE_EQ(ppc::core::mann_whitney_p_value({}, slower), 1.0);
+}
+
+TEST(perf_tests, check_perf_baseline_regression) {
+  auto make_record = [](std::vector<double> samples) {
+    ppc::core::PerfRecord record;
+    record.task_id = "example";
+    record.backend = "seq";
+    record.type_of_running = "pipeline";
+    record.phase = "total";
+    record.statistics = ppc::core::compute_statistics(samples, 3.5);
+    record.samples = std::move(samples);
+    return record;
+  };
+  ppc::core::PerfRegressionThresholds thresholds;
+
+  ppc::core::PerfBaseline baseline({make_record({1.0, 1.1, 0.9, 1.05, 0.95, 1.0, 1.02, 0.98})});
+  auto same = make_record({1.01, 1.09, 0.91, 1.04, 0.96, 1.0, 1.03, 0.97});
+  auto slower = make_record({1.2, 1.3, 1.1, 1.25, 1.15, 1.2, 1.22, 1.18});
+  auto other = make_record({5.0});
+  other.backend = "omp";
+
+  auto comparisons = baseline.compare({same, slower, other}, thresholds);
+  ASSERT_EQ(comparisons.size(), 2U);
+  EXPECT_EQ(comparisons[0].key, "example/seq/pipeline/total/1/1");
+  EXPECT_FALSE(comparisons[0].regression);
+  EXPECT_TRUE(comparisons[1].regression);
+  EXPECT_NEAR(comparisons[1].slowdown, 0.2, 1e-9);
+
+  // too small to be flagged
+  thresholds.min_time = 2.0;
+  EXPECT_FALSE(baseline.compare({slower}, thresholds)[0].regression);
+
+  // within tolerated slowdown
+  thresholds.min_time = 0.0;
+  thresholds.max_slowdown = 0.5;
+  EXPECT_FALSE(baseline.compare({slower}, thresholds)[0].regression);
+}
+
+TEST(perf_tests, check_perf_baseline_store) {
+  ppc::core::PerfRecord record;
+  record.task_id = "example";
+  record.backend = "seq";
+  record.type_of_running = "task_run";
+  record.phase = "total";
+  record.samples = {1.0};
+  auto updated = record;
+  updated.samples = {2.0};
+
+  auto path = (std::filesystem::temp_directory_path() / "ppc_perf_baseline_test.csv").string();
+  std::filesystem::remove(path);
+  ppc::core::write_perf_records(path, {record});
+  ppc::core::write_perf_records(path, {updated});
+  auto loaded = ppc::core::PerfBaseline::load(path);
+  ASSERT_EQ(loaded.size(), 1U);
+  EXPECT_EQ(loaded.find(record)->samples, updated.samples);
+
+  loaded.save(path);
+  EXPECT_EQ(ppc::core::read_perf_records(path).size(), 1U);
+  std::filesystem::remove(path);
+}
+
+TEST(perf_tests, check_rank_statistics) {
+  auto ranks = ppc::core::compute_rank_statistics({1.0, 2.0, 4.0, 1.0});
+  EXPECT_DOUBLE_EQ(ranks.max, 4.0);
+  EXPECT_DOUBLE_EQ(ranks.min, 1.0);
+  EXPECT_DOUBLE_EQ(ranks.mean, 2.0);
+  EXPECT_DOUBLE_EQ(ranks.imbalance, 2.0);
+  EXPECT_EQ(ranks.slowest_rank, 2);
+  EXPECT_TRUE(ppc::core::compute_rank_statistics({}).per_rank.empty());
+}
+
+TEST(perf_tests, check_perf_rank_synchronization) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes, second process of fake communicator is twice as slow
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 4;
+  uint64_t timer_calls = 0;
+  perfAttr->current_timer = [&] { return static_cast<double>(timer_calls++); };
+  int barriers = 0;
+  perfAttr->barrier = [&] { barriers++; };
+  int gathers = 0;
+  perfAttr->all_gather = [&](double value) {
+    gathers++;
+    return std::vector<double>{value, 2.0 * value};
+  };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  EXPECT_EQ(barriers, 2);
+  EXPECT_EQ(gathers, 1 + ppc::core::PerfResults::NUM_PHASES);
+  EXPECT_EQ(perfResults->num_processes, 2);
+  ASSERT_EQ(perfResults->ranks.per_rank.size(), 2U);
+  EXPECT_EQ(perfResults->ranks.slowest_rank, 1);
+  EXPECT_DOUBLE_EQ(perfResults->ranks.imbalance, 2.0 / 1.5);
+  const auto &run = perfResults->phases[ppc::core::PerfResults::RUN];
+  EXPECT_DOUBLE_EQ(run.ranks.max, 2.0 * run.time_sec);
+}
+
+namespace {
+
+// Task whose run() takes given time on simulated clock, so calibration can be checked exactly
+class SimulatedTask : public ppc::core::Task {
+ public:
+  SimulatedTask(std::shared_ptr<ppc::core::TaskData> taskData_, double &clock_, double duration_)
+      : Task(std::move(taskData_)), clock(clock_), duration(duration_) {}
+  bool validation() override {
+    internal_order_test();
+    return true;
+  }
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+  bool run() override {
+    internal_order_test();
+    clock += duration;
+    return true;
+  }
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+ private:
+  double &clock;
+  double duration;
+};
+
+}  // namespace
+
+TEST(perf_tests, check_perf_calibrated_iterations) {
+  double clock = 0.0;
+  auto testTask = std::make_shared<SimulatedTask>(std::make_shared<ppc::core::TaskData>(), clock, 1e-3);
+
+  // Create Perf attributes without count of runs
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->target_time = 0.5;
+  perfAttr->current_timer = [&] { return clock; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer, probe batches of 1, 2, 4 and 8 runs reach 1% of target time
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+
+  EXPECT_TRUE(perfResults->calibrated);
+  EXPECT_EQ(perfResults->num_running, 500U);
+  EXPECT_EQ(perfResults->samples.size(), 500U);
+  EXPECT_NEAR(perfResults->time_sec, 0.5, 1e-9);
+  EXPECT_NEAR(perfResults->time_per_iteration(), 1e-3, 1e-12);
+  EXPECT_EQ(perfAttr->num_running, 0U);
+
+  // Calibrated count is bounded
+  perfAttr->max_running = 100;
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  EXPECT_EQ(perfResults->num_running, 100U);
+  EXPECT_EQ(perfResults->phases[ppc::core::PerfResults::RUN].samples.size(), 100U);
+
+  // Explicit count of runs disables calibration
+  perfAttr->num_running = 7;
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  EXPECT_FALSE(perfResults->calibrated);
+  EXPECT_EQ(perfResults->samples.size(), 7U);
+}
+
+TEST(perf_tests, check_perf_calibration_agrees_on_slowest_process) {
+  double clock = 0.0;
+  auto testTask = std::make_shared<SimulatedTask>(std::make_shared<ppc::core::TaskData>(), clock, 1e-2);
+
+  // Second process of fake communicator is twice as slow, so every process runs half of iterations
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->target_time = 1.0;
+  perfAttr->current_timer = [&] { return clock; };
+  perfAttr->all_gather = [&](double value) { return std::vector<double>{value, 2.0 * value}; };
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf(testTask).task_run(perfAttr, perfResults);
+  EXPECT_EQ(perfResults->num_running, 50U);
+
+  // Timer which doesn't advance gives nothing to calibrate against
+  auto constantAttr = std::make_shared<ppc::core::PerfAttr>();
+  ppc::core::Perf(testTask).task_run(constantAttr, perfResults);
+  EXPECT_TRUE(perfResults->calibrated);
+  EXPECT_EQ(perfResults->num_running, 1U);
+}
+
+TEST(perf_tests, check_geometric_sizes) {
+  EXPECT_EQ(ppc::core::geometric_sizes(1, 100, 4.0), (std::vector<uint64_t>{1, 4, 16, 64}));
+  EXPECT_EQ(ppc::core::geometric_sizes(1, 4, 1.2), (std::vector<uint64_t>{1, 2, 3, 4}));
+  EXPECT_TRUE(ppc::core::geometric_sizes(8, 4).empty());
+  EXPECT_THROW(ppc::core::geometric_sizes(0, 4), std::invalid_argument);
+  EXPECT_THROW(ppc::core::geometric_sizes(1, 4, 1.0), std::invalid_argument);
+}
+
+TEST(perf_tests, check_fit_complexity) {
+  using Fit = ppc::core::PerfComplexityFit;
+  auto sizes = ppc::core::geometric_sizes(16, 1 << 20);
+  for (auto model : {Fit::LINEAR, Fit::N_LOG_N, Fit::QUADRATIC}) {
+    SCOPED_TRACE(Fit::model_name(model));
+    std::vector<double> times;
+    for (auto size : sizes) {
+      times.push_back(3e-9 * Fit::model_value(model, static_cast<double>(size)));
+    }
+    auto fits = ppc::core::fit_complexity(sizes, times);
+    ASSERT_EQ(fits.size(), static_cast<size_t>(Fit::NUM_MODELS));
+    EXPECT_EQ(fits.front().model, model);
+    EXPECT_NEAR(fits.front().constant, 3e-9, 1e-15);
+    EXPECT_NEAR(fits.front().r_squared, 1.0, 1e-12);
+    EXPECT_LT(fits.back().r_squared, 0.9);
+  }
+
+  std::vector<double> linear_times;
+  for (auto size : sizes) {
+    linear_times.push_back(1e-9 * static_cast<double>(size));
+  }
+  EXPECT_NEAR(ppc::core::fit_complexity_exponent(sizes, linear_times), 1.0, 1e-12);
+  EXPECT_THROW(ppc::core::fit_complexity(sizes, {1.0}), std::invalid_argument);
+}
+
+TEST(perf_tests, check_find_cache_knee) {
+  std::vector<uint64_t> sizes = {1, 2, 4, 8, 16, 32};
+  // overhead amortizes on small sizes, flat level in cache, then a step out of it
+  std::vector<double> unit_times = {5.0, 2.0, 1.0, 1.1, 1.0, 2.0};
+  EXPECT_EQ(ppc::core::find_cache_knee(sizes, unit_times, 1.3), 32U);
+  EXPECT_EQ(ppc::core::find_cache_knee(sizes, unit_times, 2.5), 0U);
+  EXPECT_EQ(ppc::core::find_cache_knee({}, {}, 1.3), 0U);
+}
+
+TEST(perf_tests, check_perf_sweep) {
+  // Simulated kernel is linear, every element costs four times more from 2^14 elements on
+  double clock = 0.0;
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  perfAttr->sizes = ppc::core::geometric_sizes(1 << 10, 1 << 16);
+  perfAttr->current_timer = [&] { return clock; };
+  std::vector<uint64_t> made_sizes;
+  auto make_task = [&](uint64_t size) {
+    made_sizes.push_back(size);
+    auto element_time = size < (1 << 14) ? 1e-9 : 4e-9;
+    return std::make_shared<SimulatedTask>(std::make_shared<ppc::core::TaskData>(), clock,
+                                           element_time * static_cast<double>(size));
+  };
+
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf::sweep_run(perfAttr, perfResults, make_task);
+
+  EXPECT_EQ(perfResults->type_of_running, ppc::core::PerfResults::TypeOfRunning::SWEEP);
+  EXPECT_EQ(made_sizes, perfAttr->sizes);
+  ASSERT_EQ(perfResults->sweep.size(), perfAttr->sizes.size());
+  EXPECT_NEAR(perfResults->sweep.front().time_sec, 1024e-9, 1e-15);
+  EXPECT_EQ(perfResults->sweep.front().samples.size(), 3U);
+  ASSERT_EQ(perfResults->complexity.size(), static_cast<size_t>(ppc::core::PerfComplexityFit::NUM_MODELS));
+  EXPECT_GT(perfResults->complexity_exponent, 1.0);
+  EXPECT_EQ(perfResults->cache_knee_size, uint64_t{1} << 14);
+  EXPECT_EQ(perfResults->input_size, uint64_t{1} << 16);
+
+  auto records = ppc::core::make_perf_records(*perfResults);
+  ASSERT_EQ(records.size(), perfResults->sweep.size());
+  EXPECT_EQ(records.back().type_of_running, "sweep");
+  EXPECT_EQ(records.back().input_size, uint64_t{1} << 16);
+  EXPECT_NE(ppc::core::PerfBaseline::key(records.front()), ppc::core::PerfBaseline::key(records.back()));
+}
@@ -3,9 +3,11 @@
 #ifndef MODULES_CORE_INCLUDE_PERF_HPP_
 #define MODULES_CORE_INCLUDE_PERF_HPP_
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "core/task/include/task.hpp"
@@ -13,20 +15,193 @@
 namespace ppc {
 namespace core {
 
+// Duration of calibrated measurement (in seconds): PPC_PERF_TARGET_TIME if set, 1 second otherwise,
+// kept inside PerfResults::MIN_TIME and PerfResults::MAX_TIME
+double default_target_time();
+
 struct PerfAttr {
-  // count of task's running
-  uint64_t num_running;
+  // count of task's timed runs, 0 to calibrate it: probe runs are timed and count is chosen so that
+  // measurement takes about target_time on any hardware
+  uint64_t num_running = 0;
+  double target_time = default_target_time();
+  // upper bound of calibrated count of runs
+  uint64_t max_running = 1000000;
+  // count of untimed runs before measurement (warm-up of caches, allocators, thread pools)
+  uint64_t num_warmup = 0;
+  // samples with robust z-score (distance from median in MADs) above threshold are outliers
+  double outlier_threshold = 3.5;
   std::function<double(void)> current_timer = [&] { return 0.0; };
+  // counts of threads for scaling run, powers of two up to hardware concurrency by default
+  std::vector<int> thread_counts;
+  // switch backend to given count of threads (omp_set_num_threads, tbb::global_control, ppc::core::set_num_threads)
+  std::function<void(int)> set_num_threads;
+  // description of measurement for reports, task id and backend are taken from test file path if empty
+  std::string task_id;
+  std::string backend;
+  int num_threads = 1;
+  int num_processes = 1;
+  // read hardware counters around every timed iteration (Linux perf_event_open), skipped if unavailable
+  bool collect_counters = false;
+  // synchronize all processes (MPI barrier), start and stop of measurement are aligned by it
+  std::function<void()> barrier;
+  // value of every process in order of ranks (MPI all-gather), enables per-rank statistics
+  std::function<std::vector<double>(double)> all_gather;
+  // input sizes of sweep run, geometric range from 2^10 to 2^22 by default
+  std::vector<uint64_t> sizes;
+  // rise of time per unit of fitted model above its level on smaller sizes which is taken as cache knee
+  double knee_threshold = 1.3;
+};
+
+// Statistics of per-iteration samples (in seconds). Order statistics (min, median,
+// percentiles, max) are taken over all samples so that tail latency is preserved;
+// mean and stddev are taken over samples left after outlier rejection.
+struct PerfStatistics {
+  double min = 0.0;
+  double median = 0.0;
+  double mean = 0.0;
+  double p95 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+  double stddev = 0.0;
+  uint64_t num_outliers = 0;
+};
+
+// Spread of time over processes, distributed run is as slow as its slowest rank
+struct PerfRankStatistics {
+  std::vector<double> per_rank;
+  double max = 0.0;
+  double min = 0.0;
+  double mean = 0.0;
+  // max / mean, 1 means perfectly balanced load
+  double imbalance = 0.0;
+  int slowest_rank = 0;
+};
+
+struct PerfPhaseResults {
+  // cumulative time of phase over all timed iterations (in seconds)
+  double time_sec = 0.0;
+  // time of phase on every timed iteration (in seconds)
+  std::vector<double> samples;
+  PerfStatistics statistics;
+  // cumulative time of phase on every process, filled if PerfAttr::all_gather is set
+  PerfRankStatistics ranks;
+};
+
+struct PerfScalingPoint {
+  int num_threads = 0;
+  // median time of pipeline iteration (in seconds)
+  double time_sec = 0.0;
+  // relative to sequential version of task
+  double speedup = 0.0;
+  double efficiency = 0.0;
+  std::vector<double> samples;
+  PerfStatistics statistics;
+};
+
+// Model of time t(n) = constant * g(n) fitted to timings of sweep run in log space, so every size
+// weighs the same however far the range spans
+struct PerfComplexityFit {
+  enum Model { LINEAR, N_LOG_N, QUADRATIC, NUM_MODELS };
+  static const char* model_name(Model model);
+  // g(n) of model, logarithm is binary
+  static double model_value(Model model, double size);
+  Model model = LINEAR;
+  // seconds per unit of g(n)
+  double constant = 0.0;
+  // coefficient of determination of log t, 1 means timings follow the model exactly
+  double r_squared = 0.0;
+};
+
+struct PerfSweepPoint {
+  uint64_t size = 0;
+  // median time of task's run() (in seconds)
+  double time_sec = 0.0;
+  // time per unit of g(n) of best fitted model, flat while working set fits in cache
+  double unit_time = 0.0;
+  std::vector<double> samples;
+  PerfStatistics statistics;
+};
+
+// Hardware counters of all threads of the process which exist when timed iterations start, user space only
+struct PerfCounterResults {
+  enum Counter { CYCLES, INSTRUCTIONS, CACHE_MISSES, BRANCH_MISSES, LLC_REFERENCES, NUM_COUNTERS };
+  using Values = std::array<uint64_t, NUM_COUNTERS>;
+  static const char* counter_name(Counter counter);
+  // counters the kernel let us open, values of others stay zero
+  std::array<bool, NUM_COUNTERS> available{};
+  // counts on every timed iteration, empty if no counter is available
+  std::vector<Values> samples;
+  Values total{};
+  bool any_available() const;
+  // instructions per cycle
+  double ipc() const;
+  // share of last level cache references which missed
+  double cache_miss_rate() const;
+  // branch misses per thousand instructions
+  double branch_mpki() const;
 };
 
 struct PerfResults {
   // measurement of task's time (in seconds)
   double time_sec = 0.0;
-  enum TypeOfRunning { PIPELINE, TASK_RUN, NONE } type_of_running = NONE;
+  // measurement of every timed iteration (in seconds)
+  std::vector<double> samples;
+  PerfStatistics statistics;
+  // count of timed iterations, chosen by calibration if PerfAttr::num_running is 0
+  uint64_t num_running = 0;
+  bool calibrated = false;
+  // mean time of timed iteration (in seconds)
+  double time_per_iteration() const;
+  // busy time of every process (sum of its samples), filled if PerfAttr::all_gather is set
+  PerfRankStatistics ranks;
+  // breakdown of pipeline run by task's functions
+  enum Phase { VALIDATION, PRE_PROCESSING, RUN, POST_PROCESSING, NUM_PHASES };
+  std::array<PerfPhaseResults, NUM_PHASES> phases;
+  static const char* phase_name(Phase phase);
+  // filled if PerfAttr::collect_counters is set
+  PerfCounterResults counters;
+  // speedup and efficiency curve of scaling run
+  double seq_time_sec = 0.0;
+  std::vector<PerfScalingPoint> scaling;
+  // timings of sweep run over input sizes, fits of all models with the best one first
+  std::vector<PerfSweepPoint> sweep;
+  std::vector<PerfComplexityFit> complexity;
+  // slope of log t over log n, empirical exponent of growth
+  double complexity_exponent = 0.0;
+  // first size where time per unit of best model rises above PerfAttr::knee_threshold times its minimum
+  // over smaller sizes (caches stop helping), 0 if there is no such size
+  uint64_t cache_knee_size = 0;
+  enum TypeOfRunning { PIPELINE, TASK_RUN, SCALING, SWEEP, NONE } type_of_running = NONE;
+  static const char* type_of_running_name(TypeOfRunning type_of_running);
+  // description of measurement copied from PerfAttr
+  std::string task_id;
+  std::string backend;
+  int num_threads = 1;
+  int num_processes = 1;
+  // total count of input elements of task
+  uint64_t input_size = 0;
   constexpr const static double MAX_TIME = 10.0;
   constexpr const static double MIN_TIME = 0.05;
 };
 
+// Compute statistics of samples, rejecting outliers by robust z-score
+PerfStatistics compute_statistics(std::vector<double> samples, double outlier_threshold);
+
+// Compute spread of per-rank values
+PerfRankStatistics compute_rank_statistics(std::vector<double> per_rank);
+
+// Sizes first, first * factor, ... not greater than last
+std::vector<uint64_t> geometric_sizes(uint64_t first, uint64_t last, double factor = 2.0);
+
+// Fit every complexity model to times measured on sizes, best fit first
+std::vector<PerfComplexityFit> fit_complexity(const std::vector<uint64_t>& sizes, const std::vector<double>& times);
+
+// Slope of least squares line of log t over log n
+double fit_complexity_exponent(const std::vector<uint64_t>& sizes, const std::vector<double>& times);
+
+// First size whose unit time exceeds threshold times the minimum over smaller sizes, 0 if none does
+uint64_t find_cache_knee(const std::vector<uint64_t>& sizes, const std::vector<double>& unit_times, double threshold);
+
 class Perf {
  public:
   // Init performance analysis with initialized task and initialized data
@@ -40,13 +215,30 @@ class Perf {
                     const std::shared_ptr<ppc::core::PerfResults>& perfResults);
   // Check performance of task's run() function
   void task_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+  // Check pipeline over perfAttr->thread_counts against pipeline of sequential version of task,
+  // or against pipeline of the task itself on one thread if seq_task is null
+  void scaling_run(const std::shared_ptr<PerfAttr>& perfAttr,
+                   const std::shared_ptr<ppc::core::PerfResults>& perfResults,
+                   const std::shared_ptr<Task>& seq_task = nullptr);
+  // Check task's run() over perfAttr->sizes with tasks made by make_task(size), which own their input,
+  // and fit complexity models to median times
+  static void sweep_run(const std::shared_ptr<PerfAttr>& perfAttr,
+                        const std::shared_ptr<ppc::core::PerfResults>& perfResults,
+                        const std::function<std::shared_ptr<Task>(uint64_t)>& make_task);
   // Pint results for automation checkers
   static void print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults);
 
  private:
   std::shared_ptr<Task> task;
+  void describe_run(const std::shared_ptr<PerfAttr>& perfAttr,
+                    const std::shared_ptr<ppc::core::PerfResults>& perfResults) const;
+  static void gather_ranks(const std::shared_ptr<PerfAttr>& perfAttr,
+                           const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+  static uint64_t calibrate(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline);
+  // record_phases(begin, end) is called with bounds of every timed iteration
   static void common_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline,
-                         const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+                         const std::shared_ptr<ppc::core::PerfResults>& perfResults,
+                         const std::function<void(double, double)>& record_phases = nullptr);
 };
 
 }  // namespace core
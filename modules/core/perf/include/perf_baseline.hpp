@@ -0,0 +1,69 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PERF_BASELINE_HPP_
+#define MODULES_CORE_INCLUDE_PERF_BASELINE_HPP_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/perf_report.hpp"
+
+namespace ppc::core {
+
+struct PerfRegressionThresholds {
+  // relative growth of median time which is tolerated, 0.05 means 5%
+  double max_slowdown = 0.05;
+  // one-sided p-value of Mann-Whitney U test below which slowdown is treated as real
+  double significance = 0.01;
+  // with fewer samples on either side the test has no power and only max_slowdown is checked
+  uint64_t min_samples = 5;
+  // series with baseline median below this time (in seconds) are compared but never flagged
+  double min_time = 1e-4;
+  // defaults overridden by PPC_PERF_MAX_SLOWDOWN, PPC_PERF_SIGNIFICANCE and PPC_PERF_MIN_TIME
+  static PerfRegressionThresholds from_env();
+};
+
+struct PerfComparison {
+  std::string key;
+  double baseline_median = 0.0;
+  double current_median = 0.0;
+  // current median relative to baseline one minus one, positive means slower
+  double slowdown = 0.0;
+  double p_value = 1.0;
+  bool regression = false;
+};
+
+// Previous results keyed by task id, backend, type of running, phase and counts of threads and processes.
+// Stored in the same CSV or JSON Lines format as perf reports, so any report can become a baseline.
+class PerfBaseline {
+ public:
+  PerfBaseline() = default;
+  explicit PerfBaseline(const std::vector<PerfRecord>& records);
+  // later records with the same key replace earlier ones, so appended reports keep the latest run
+  static PerfBaseline load(const std::string& path);
+  void save(const std::string& path) const;
+
+  static std::string key(const PerfRecord& record);
+  const PerfRecord* find(const PerfRecord& record) const;
+  size_t size() const { return records.size(); }
+
+  // Compare every current record having a baseline, records without one are skipped
+  std::vector<PerfComparison> compare(const std::vector<PerfRecord>& current,
+                                      const PerfRegressionThresholds& thresholds) const;
+
+ private:
+  std::map<std::string, PerfRecord> records;
+};
+
+PerfComparison compare_perf_record(const PerfRecord& baseline, const PerfRecord& current,
+                                   const PerfRegressionThresholds& thresholds);
+
+// One-sided p-value of hypothesis that current samples are not larger than baseline ones
+// (Mann-Whitney U test with normal approximation, tie and continuity corrections)
+double mann_whitney_p_value(const std::vector<double>& baseline, const std::vector<double>& current);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PERF_BASELINE_HPP_
@@ -0,0 +1,44 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PERF_COUNTERS_HPP_
+#define MODULES_CORE_INCLUDE_PERF_COUNTERS_HPP_
+
+#include <array>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+
+namespace ppc::core {
+
+// Hardware counters opened with perf_event_open on construction and closed on destruction.
+// Counters are opened on every thread which exists at construction, so workers of thread pools
+// started by warm-up are counted along with calling thread and read() sums all of them; threads
+// started later aren't counted. Counters of one thread are opened as one group, so their ratios
+// are taken over the same time even when the kernel multiplexes them. Counters the kernel, the
+// container or the CPU refuse are just left out; on other systems nothing is available.
+class PerfCounters {
+ public:
+  PerfCounters();
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+  ~PerfCounters();
+
+  bool available(PerfCounterResults::Counter counter) const { return opened[counter]; }
+  bool any_available() const;
+  // Current counts of all threads, scaled up if the kernel multiplexed counters
+  PerfCounterResults::Values read() const;
+
+ private:
+  struct Group {
+    int leader = -1;
+    std::vector<int> descriptors;
+    // counter of every member in order of opening, which is order of values read from leader
+    std::vector<PerfCounterResults::Counter> counters;
+  };
+  std::vector<Group> groups;
+  std::array<bool, PerfCounterResults::NUM_COUNTERS> opened{};
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PERF_COUNTERS_HPP_
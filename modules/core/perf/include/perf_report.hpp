@@ -0,0 +1,56 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PERF_REPORT_HPP_
+#define MODULES_CORE_INCLUDE_PERF_REPORT_HPP_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+
+namespace ppc::core {
+
+// Machine and build the measurement was taken on
+struct PerfEnvironment {
+  std::string cpu_model;
+  std::string compiler;
+  std::string compiler_flags;
+  std::string git_revision;
+  static const PerfEnvironment& current();
+};
+
+// One measured series of machine-readable report, keyed by task id, backend, type of running and phase
+struct PerfRecord {
+  std::string task_id;
+  std::string backend;
+  std::string type_of_running;
+  // "total" for whole iterations or name of task's function
+  std::string phase;
+  int num_threads = 1;
+  int num_processes = 1;
+  uint64_t input_size = 0;
+  // relative to sequential version of task, set by scaling run only
+  double speedup = 0.0;
+  double efficiency = 0.0;
+  std::vector<double> samples;
+  PerfStatistics statistics;
+  PerfEnvironment environment;
+};
+
+// Split results into records: iterations, every phase of pipeline and every point of scaling and sweep runs
+std::vector<PerfRecord> make_perf_records(const PerfResults& perfResults);
+
+// Append records to file, CSV if path ends with ".csv" and JSON Lines otherwise
+void write_perf_records(const std::string& path, const std::vector<PerfRecord>& records);
+
+// Read records written by write_perf_records, format is chosen by extension the same way
+std::vector<PerfRecord> read_perf_records(const std::string& path);
+
+// Task id and backend of test file placed as "tasks/<backend>/<task id>/perf_tests/..."
+std::pair<std::string, std::string> task_id_from_path(const std::string& path);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PERF_REPORT_HPP_
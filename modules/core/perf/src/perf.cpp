@@ -3,11 +3,37 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <sstream>
+#include <thread>
 #include <utility>
 
+#include "core/perf/include/perf_baseline.hpp"
+#include "core/perf/include/perf_counters.hpp"
+#include "core/perf/include/perf_report.hpp"
+
+namespace {
+
+// Calls phase of task and closes its trace span as soon as it returns, so time spent between
+// phases stays visible in the trace
+template <class Phase>
+void run_phase(ppc::core::Task& task, Phase phase) {
+  struct PhaseEnd {
+    ppc::core::Task& task;
+    ~PhaseEnd() { task.end_phase(); }
+  } phase_end{task};
+  (task.*phase)();
+}
+
+}  // namespace
+
 ppc::core::Perf::Perf(std::shared_ptr<Task> task_) { set_task(std::move(task_)); }
 
 void ppc::core::Perf::set_task(std::shared_ptr<Task> task_) {
@@ -18,64 +44,509 @@ void ppc::core::Perf::set_task(std::shared_ptr<Task> task_) {
 void ppc::core::Perf::pipeline_run(const std::shared_ptr<PerfAttr>& perfAttr,
                                    const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
   perfResults->type_of_running = PerfResults::TypeOfRunning::PIPELINE;
+  describe_run(perfAttr, perfResults);
 
+  // Phase boundaries inside an iteration are read here, its begin and end are shared with common_run,
+  // so the breakdown adds three timer reads per iteration and phases sum up to the iteration sample
+  auto& phases = perfResults->phases;
+  std::array<double, PerfResults::NUM_PHASES + 1> time_points{};
   common_run(
-      std::move(perfAttr),
+      perfAttr,
       [&]() {
-        task->validation();
-        task->pre_processing();
-        task->run();
-        task->post_processing();
+        run_phase(*task, &Task::validation);
+        time_points[PerfResults::PRE_PROCESSING] = perfAttr->current_timer();
+        run_phase(*task, &Task::pre_processing);
+        time_points[PerfResults::RUN] = perfAttr->current_timer();
+        run_phase(*task, &Task::run);
+        time_points[PerfResults::POST_PROCESSING] = perfAttr->current_timer();
+        run_phase(*task, &Task::post_processing);
       },
-      std::move(perfResults));
+      perfResults,
+      [&](double iteration_begin, double iteration_end) {
+        time_points[PerfResults::VALIDATION] = iteration_begin;
+        time_points[PerfResults::NUM_PHASES] = iteration_end;
+        for (size_t i = 0; i < PerfResults::NUM_PHASES; i++) {
+          phases[i].samples.push_back(time_points[i + 1] - time_points[i]);
+        }
+      });
+
+  for (auto& phase : phases) {
+    phase.time_sec = std::accumulate(phase.samples.begin(), phase.samples.end(), 0.0);
+    phase.statistics = compute_statistics(phase.samples, perfAttr->outlier_threshold);
+  }
+  gather_ranks(perfAttr, perfResults);
 }
 
 void ppc::core::Perf::task_run(const std::shared_ptr<PerfAttr>& perfAttr,
                                const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
   perfResults->type_of_running = PerfResults::TypeOfRunning::TASK_RUN;
+  describe_run(perfAttr, perfResults);
+
+  run_phase(*task, &Task::validation);
+  run_phase(*task, &Task::pre_processing);
+  common_run(perfAttr, [&]() { run_phase(*task, &Task::run); }, perfResults);
+  run_phase(*task, &Task::post_processing);
+  gather_ranks(perfAttr, perfResults);
+
+  run_phase(*task, &Task::validation);
+  run_phase(*task, &Task::pre_processing);
+  run_phase(*task, &Task::run);
+  run_phase(*task, &Task::post_processing);
+}
+
+void ppc::core::Perf::scaling_run(const std::shared_ptr<PerfAttr>& perfAttr,
+                                  const std::shared_ptr<ppc::core::PerfResults>& perfResults,
+                                  const std::shared_ptr<Task>& seq_task) {
+  auto thread_counts = perfAttr->thread_counts;
+  if (thread_counts.empty()) {
+    auto max_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int num_threads = 1; num_threads < max_threads; num_threads *= 2) {
+      thread_counts.push_back(num_threads);
+    }
+    thread_counts.push_back(max_threads);
+  }
 
-  task->validation();
-  task->pre_processing();
-  common_run(std::move(perfAttr), [&]() { task->run(); }, std::move(perfResults));
-  task->post_processing();
+  // without sequential version of task the baseline is the parallel task on one thread
+  auto seq_results = std::make_shared<PerfResults>();
+  if (seq_task) {
+    Perf(seq_task).pipeline_run(perfAttr, seq_results);
+  } else {
+    if (perfAttr->set_num_threads) {
+      perfAttr->set_num_threads(1);
+    }
+    pipeline_run(perfAttr, seq_results);
+  }
+  auto seq_time = seq_results->statistics.median;
+
+  std::vector<PerfScalingPoint> scaling;
+  for (auto num_threads : thread_counts) {
+    if (perfAttr->set_num_threads) {
+      perfAttr->set_num_threads(num_threads);
+    }
+    pipeline_run(perfAttr, perfResults);
 
-  task->validation();
-  task->pre_processing();
-  task->run();
-  task->post_processing();
+    PerfScalingPoint point;
+    point.num_threads = num_threads;
+    point.time_sec = perfResults->statistics.median;
+    point.speedup = point.time_sec > 0.0 ? seq_time / point.time_sec : 0.0;
+    point.efficiency = point.speedup / num_threads;
+    point.samples = perfResults->samples;
+    point.statistics = perfResults->statistics;
+    scaling.push_back(std::move(point));
+  }
+
+  perfResults->type_of_running = PerfResults::TypeOfRunning::SCALING;
+  perfResults->seq_time_sec = seq_time;
+  perfResults->scaling = std::move(scaling);
+}
+
+void ppc::core::Perf::sweep_run(const std::shared_ptr<PerfAttr>& perfAttr,
+                                const std::shared_ptr<ppc::core::PerfResults>& perfResults,
+                                const std::function<std::shared_ptr<Task>(uint64_t)>& make_task) {
+  auto sizes = perfAttr->sizes.empty() ? geometric_sizes(uint64_t{1} << 10, uint64_t{1} << 22) : perfAttr->sizes;
+
+  std::vector<PerfSweepPoint> sweep;
+  std::vector<double> times;
+  for (auto size : sizes) {
+    // task and its input live for one point only, so the largest input isn't held during the whole sweep
+    Perf(make_task(size)).task_run(perfAttr, perfResults);
+
+    PerfSweepPoint point;
+    point.size = size;
+    point.time_sec = perfResults->statistics.median;
+    point.samples = perfResults->samples;
+    point.statistics = perfResults->statistics;
+    times.push_back(point.time_sec);
+    sweep.push_back(std::move(point));
+  }
+
+  auto complexity = fit_complexity(sizes, times);
+  std::vector<double> unit_times;
+  for (auto& point : sweep) {
+    auto model_value = PerfComplexityFit::model_value(complexity.front().model, static_cast<double>(point.size));
+    point.unit_time = model_value > 0.0 ? point.time_sec / model_value : 0.0;
+    unit_times.push_back(point.unit_time);
+  }
+
+  perfResults->type_of_running = PerfResults::TypeOfRunning::SWEEP;
+  perfResults->input_size = sizes.back();
+  perfResults->complexity_exponent = fit_complexity_exponent(sizes, times);
+  perfResults->cache_knee_size = find_cache_knee(sizes, unit_times, perfAttr->knee_threshold);
+  perfResults->complexity = std::move(complexity);
+  perfResults->sweep = std::move(sweep);
+}
+
+void ppc::core::Perf::describe_run(const std::shared_ptr<PerfAttr>& perfAttr,
+                                   const std::shared_ptr<ppc::core::PerfResults>& perfResults) const {
+  perfResults->task_id = perfAttr->task_id;
+  perfResults->backend = perfAttr->backend;
+  perfResults->num_threads = perfAttr->num_threads;
+  perfResults->num_processes = perfAttr->num_processes;
+  const auto& inputs_count = task->get_data()->inputs_count;
+  perfResults->input_size = std::accumulate(inputs_count.begin(), inputs_count.end(), uint64_t{0});
+}
+
+uint64_t ppc::core::Perf::calibrate(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline) {
+  // Batch of probe runs doubles until it takes a measurable share of target time, so the count isn't
+  // derived from a single run below timer resolution. Decisions are taken on time of the slowest
+  // process, so every process runs the same count of iterations (pipeline may have collectives).
+  auto max_running = std::max<uint64_t>(perfAttr->max_running, 1);
+  auto min_probe_time = perfAttr->target_time / 100.0;
+  uint64_t batch = 1;
+  uint64_t num_probes = 0;
+  double elapsed = 0.0;
+  while (true) {
+    if (perfAttr->barrier) {
+      perfAttr->barrier();
+    }
+    auto begin = perfAttr->current_timer();
+    for (uint64_t i = 0; i < batch; i++) {
+      pipeline();
+    }
+    elapsed = perfAttr->current_timer() - begin;
+    if (perfAttr->all_gather) {
+      auto per_rank = perfAttr->all_gather(elapsed);
+      elapsed = *std::max_element(per_rank.begin(), per_rank.end());
+    }
+    num_probes += batch;
+    if (elapsed <= 0.0) {
+      // timer doesn't advance, there is nothing to calibrate against
+      return 1;
+    }
+    if (elapsed >= min_probe_time || num_probes >= max_running) {
+      break;
+    }
+    batch *= 2;
+  }
+  auto count = perfAttr->target_time * static_cast<double>(batch) / elapsed;
+  return static_cast<uint64_t>(std::clamp(std::round(count), 1.0, static_cast<double>(max_running)));
 }
 
 void ppc::core::Perf::common_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline,
-                                 const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+                                 const std::shared_ptr<ppc::core::PerfResults>& perfResults,
+                                 const std::function<void(double, double)>& record_phases) {
+  for (uint64_t i = 0; i < perfAttr->num_warmup; i++) {
+    pipeline();
+  }
+  perfResults->calibrated = perfAttr->num_running == 0;
+  perfResults->num_running = perfResults->calibrated ? calibrate(perfAttr, pipeline) : perfAttr->num_running;
+  auto num_running = perfResults->num_running;
+
+  perfResults->phases = {};
+  if (record_phases) {
+    for (auto& phase : perfResults->phases) {
+      phase.samples.reserve(num_running);
+    }
+  }
+  perfResults->samples.clear();
+  perfResults->samples.reserve(num_running);
+
+  perfResults->counters = {};
+  std::unique_ptr<PerfCounters> counters;
+  if (perfAttr->collect_counters) {
+    counters = std::make_unique<PerfCounters>();
+    if (counters->any_available()) {
+      for (size_t i = 0; i < PerfCounterResults::NUM_COUNTERS; i++) {
+        perfResults->counters.available[i] = counters->available(static_cast<PerfCounterResults::Counter>(i));
+      }
+      perfResults->counters.samples.reserve(num_running);
+    } else {
+      counters.reset();
+    }
+  }
+
+  // Timestamps and counts are chained, so the timer and counters are read once per iteration
+  // (timer twice with counters, their reading is left out of samples)
+  if (perfAttr->barrier) {
+    perfAttr->barrier();
+  }
+  // counted after the barrier, waiting for other processes isn't work of the first iteration
+  PerfCounterResults::Values counts_begin{};
+  if (counters) {
+    counts_begin = counters->read();
+  }
   auto begin = perfAttr->current_timer();
-  for (uint64_t i = 0; i < perfAttr->num_running; i++) {
+  auto iteration_begin = begin;
+  auto end = begin;
+  // spent reading counters, left out of time_sec as well
+  double counters_time = 0.0;
+  for (uint64_t i = 0; i < num_running; i++) {
     pipeline();
+    auto iteration_end = perfAttr->current_timer();
+    end = iteration_end;
+    perfResults->samples.push_back(iteration_end - iteration_begin);
+    if (record_phases) {
+      record_phases(iteration_begin, iteration_end);
+    }
+    iteration_begin = iteration_end;
+    if (counters) {
+      auto counts_end = counters->read();
+      auto& sample = perfResults->counters.samples.emplace_back();
+      for (size_t j = 0; j < PerfCounterResults::NUM_COUNTERS; j++) {
+        sample[j] = counts_end[j] - counts_begin[j];
+        perfResults->counters.total[j] += sample[j];
+      }
+      counts_begin = counts_end;
+      // reading counters costs syscalls, the next sample starts after them
+      iteration_begin = perfAttr->current_timer();
+      counters_time += iteration_begin - iteration_end;
+    }
   }
-  auto end = perfAttr->current_timer();
-  perfResults->time_sec = end - begin;
+  if (perfAttr->barrier) {
+    // measurement stops when the slowest process is done
+    perfAttr->barrier();
+    end = perfAttr->current_timer();
+  }
+  perfResults->time_sec = end - begin - counters_time;
+  perfResults->statistics = compute_statistics(perfResults->samples, perfAttr->outlier_threshold);
+}
+
+void ppc::core::Perf::gather_ranks(const std::shared_ptr<PerfAttr>& perfAttr,
+                                   const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  if (!perfAttr->all_gather) {
+    return;
+  }
+  // every process makes the same sequence of collective calls
+  const auto& samples = perfResults->samples;
+  auto busy_time = std::accumulate(samples.begin(), samples.end(), 0.0);
+  perfResults->ranks = compute_rank_statistics(perfAttr->all_gather(busy_time));
+  perfResults->num_processes = static_cast<int>(perfResults->ranks.per_rank.size());
+  if (perfResults->type_of_running == PerfResults::TypeOfRunning::PIPELINE) {
+    for (auto& phase : perfResults->phases) {
+      phase.ranks = compute_rank_statistics(perfAttr->all_gather(phase.time_sec));
+    }
+  }
+}
+
+double ppc::core::default_target_time() {
+  auto target_time = 1.0;
+  if (const char* env = std::getenv("PPC_PERF_TARGET_TIME")) {
+    try {
+      auto value = std::stod(env);
+      // NaN would pass through clamp
+      if (std::isfinite(value)) {
+        target_time = value;
+      }
+    } catch (const std::exception&) {
+      // ignore malformed value and fall back to default time
+    }
+  }
+  // margin from the bounds leaves room for error of calibration
+  return std::clamp(target_time, 2 * PerfResults::MIN_TIME, PerfResults::MAX_TIME / 2);
+}
+
+double ppc::core::PerfResults::time_per_iteration() const {
+  return num_running == 0 ? 0.0 : time_sec / static_cast<double>(num_running);
+}
+
+ppc::core::PerfRankStatistics ppc::core::compute_rank_statistics(std::vector<double> per_rank) {
+  PerfRankStatistics result;
+  result.per_rank = std::move(per_rank);
+  const auto& values = result.per_rank;
+  if (values.empty()) {
+    return result;
+  }
+  auto [min_it, max_it] = std::minmax_element(values.begin(), values.end());
+  result.min = *min_it;
+  result.max = *max_it;
+  result.slowest_rank = static_cast<int>(max_it - values.begin());
+  result.mean = std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+  result.imbalance = result.mean > 0.0 ? result.max / result.mean : 1.0;
+  return result;
+}
+
+const char* ppc::core::PerfCounterResults::counter_name(Counter counter) {
+  switch (counter) {
+    case CYCLES:
+      return "cycles";
+    case INSTRUCTIONS:
+      return "instructions";
+    case CACHE_MISSES:
+      return "cache_misses";
+    case BRANCH_MISSES:
+      return "branch_misses";
+    case LLC_REFERENCES:
+      return "llc_references";
+    default:
+      return "none";
+  }
+}
+
+bool ppc::core::PerfCounterResults::any_available() const {
+  return std::find(available.begin(), available.end(), true) != available.end();
+}
+
+double ppc::core::PerfCounterResults::ipc() const {
+  return total[CYCLES] == 0 ? 0.0 : static_cast<double>(total[INSTRUCTIONS]) / static_cast<double>(total[CYCLES]);
+}
+
+double ppc::core::PerfCounterResults::cache_miss_rate() const {
+  return total[LLC_REFERENCES] == 0
+             ? 0.0
+             : static_cast<double>(total[CACHE_MISSES]) / static_cast<double>(total[LLC_REFERENCES]);
+}
+
+double ppc::core::PerfCounterResults::branch_mpki() const {
+  return total[INSTRUCTIONS] == 0
+             ? 0.0
+             : 1000.0 * static_cast<double>(total[BRANCH_MISSES]) / static_cast<double>(total[INSTRUCTIONS]);
+}
+
+const char* ppc::core::PerfResults::phase_name(Phase phase) {
+  switch (phase) {
+    case VALIDATION:
+      return "validation";
+    case PRE_PROCESSING:
+      return "pre_processing";
+    case RUN:
+      return "run";
+    case POST_PROCESSING:
+      return "post_processing";
+    default:
+      return "none";
+  }
+}
+
+const char* ppc::core::PerfResults::type_of_running_name(TypeOfRunning type_of_running) {
+  switch (type_of_running) {
+    case PIPELINE:
+      return "pipeline";
+    case TASK_RUN:
+      return "task_run";
+    case SCALING:
+      return "scaling";
+    case SWEEP:
+      return "sweep";
+    default:
+      return "none";
+  }
+}
+
+namespace {
+
+// Linear interpolation between closest ranks of sorted samples
+double percentile(const std::vector<double>& sorted, double p) {
+  auto pos = p * static_cast<double>(sorted.size() - 1);
+  auto lower = static_cast<size_t>(std::floor(pos));
+  auto upper = std::min(lower + 1, sorted.size() - 1);
+  return sorted[lower] + (sorted[upper] - sorted[lower]) * (pos - static_cast<double>(lower));
+}
+
+}  // namespace
+
+ppc::core::PerfStatistics ppc::core::compute_statistics(std::vector<double> samples, double outlier_threshold) {
+  PerfStatistics statistics;
+  if (samples.empty()) {
+    return statistics;
+  }
+
+  std::sort(samples.begin(), samples.end());
+  statistics.min = samples.front();
+  statistics.max = samples.back();
+  statistics.median = percentile(samples, 0.5);
+  statistics.p95 = percentile(samples, 0.95);
+  statistics.p99 = percentile(samples, 0.99);
+
+  // Median absolute deviation, scaled to be consistent with stddev of normal distribution
+  std::vector<double> deviations(samples.size());
+  std::transform(samples.begin(), samples.end(), deviations.begin(),
+                 [&](double x) { return std::abs(x - statistics.median); });
+  std::sort(deviations.begin(), deviations.end());
+  auto mad = 1.4826 * percentile(deviations, 0.5);
+
+  auto is_outlier = [&](double x) { return mad > 0.0 && std::abs(x - statistics.median) / mad > outlier_threshold; };
+
+  double sum = 0.0;
+  uint64_t count = 0;
+  for (auto x : samples) {
+    if (is_outlier(x)) {
+      statistics.num_outliers++;
+      continue;
+    }
+    sum += x;
+    count++;
+  }
+  statistics.mean = sum / static_cast<double>(count);
+
+  if (count > 1) {
+    double sum_sq = 0.0;
+    for (auto x : samples) {
+      if (!is_outlier(x)) {
+        sum_sq += (x - statistics.mean) * (x - statistics.mean);
+      }
+    }
+    statistics.stddev = std::sqrt(sum_sq / static_cast<double>(count - 1));
+  }
+  return statistics;
 }
 
 void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults) {
-  std::string relative_path(::testing::UnitTest::GetInstance()->current_test_info()->file());
-  std::string ppc_regex_template("parallel_programming_course");
-  std::string perf_regex_template("perf_tests");
-  std::string type_test_name;
+  auto [task_id, backend] = task_id_from_path(::testing::UnitTest::GetInstance()->current_test_info()->file());
+  std::string relative_path("tasks/" + backend + "/" + task_id);
+  std::string type_test_name(PerfResults::type_of_running_name(perfResults->type_of_running));
 
   auto time_secs = perfResults->time_sec;
 
-  if (perfResults->type_of_running == PerfResults::TypeOfRunning::TASK_RUN) {
-    type_test_name = "task_run";
-  } else if (perfResults->type_of_running == PerfResults::TypeOfRunning::PIPELINE) {
-    type_test_name = "pipeline";
-  } else if (perfResults->type_of_running == PerfResults::TypeOfRunning::NONE) {
-    type_test_name = "none";
+  auto report_path = std::getenv("PPC_PERF_REPORT");
+  auto baseline_path = std::getenv("PPC_PERF_BASELINE");
+  if (report_path != nullptr || baseline_path != nullptr) {
+    auto described_results = *perfResults;
+    if (described_results.task_id.empty()) {
+      described_results.task_id = task_id;
+    }
+    if (described_results.backend.empty()) {
+      described_results.backend = backend;
+    }
+    auto records = make_perf_records(described_results);
+    // baseline is read before the report is appended, so both may name one file updated in place
+    PerfBaseline baseline;
+    if (baseline_path != nullptr && std::filesystem::exists(baseline_path)) {
+      baseline = PerfBaseline::load(baseline_path);
+    }
+    if (report_path != nullptr) {
+      write_perf_records(report_path, records);
+    }
+    if (baseline.size() > 0) {
+      auto comparisons = baseline.compare(records, PerfRegressionThresholds::from_env());
+      for (const auto& comparison : comparisons) {
+        std::cout << std::scientific << std::setprecision(4) << "Baseline " << comparison.key
+                  << " (secs): median=" << comparison.baseline_median << " -> " << comparison.current_median
+                  << std::fixed << std::setprecision(1) << " slowdown=" << 100.0 * comparison.slowdown << "%"
+                  << std::setprecision(4) << " p=" << comparison.p_value << std::defaultfloat << std::endl;
+        EXPECT_FALSE(comparison.regression) << "Performance regression of " << comparison.key << ": median "
+                                            << comparison.baseline_median << " -> " << comparison.current_median
+                                            << " secs, p-value " << comparison.p_value;
+      }
+    }
   }
 
-  auto first_found_position = relative_path.find(ppc_regex_template) + ppc_regex_template.length() + 1;
-  relative_path.erase(0, first_found_position);
+  if (perfResults->type_of_running == PerfResults::TypeOfRunning::SCALING) {
+    // path:scaling:seq:time for sequential version, path:scaling:threads:time:speedup:efficiency for each point
+    std::cout << relative_path << ":" << type_test_name << ":seq:" << std::fixed << std::setprecision(10)
+              << perfResults->seq_time_sec << std::endl;
+    for (const auto& point : perfResults->scaling) {
+      std::cout << relative_path << ":" << type_test_name << ":" << point.num_threads << ":" << point.time_sec << ":"
+                << point.speedup << ":" << point.efficiency << std::endl;
+    }
+    std::cout << std::defaultfloat;
+    return;
+  }
 
-  auto last_found_position = relative_path.find(perf_regex_template) - 1;
-  relative_path.erase(last_found_position, relative_path.length() - 1);
+  if (perfResults->type_of_running == PerfResults::TypeOfRunning::SWEEP) {
+    // path:sweep:size:time:unit_time for each point, then fits of models with the best one first
+    for (const auto& point : perfResults->sweep) {
+      std::cout << relative_path << ":" << type_test_name << ":" << point.size << ":" << std::scientific
+                << std::setprecision(4) << point.time_sec << ":" << point.unit_time << std::defaultfloat << std::endl;
+    }
+    for (const auto& fit : perfResults->complexity) {
+      std::cout << "Complexity " << PerfComplexityFit::model_name(fit.model) << ": constant=" << std::scientific
+                << std::setprecision(4) << fit.constant << std::fixed << " r2=" << fit.r_squared << std::defaultfloat
+                << std::endl;
+    }
+    std::cout << std::fixed << std::setprecision(3) << "Complexity exponent=" << perfResults->complexity_exponent
+              << std::defaultfloat << " cache_knee_size=" << perfResults->cache_knee_size << std::endl;
+    return;
+  }
 
   std::stringstream perf_res_str;
   if (time_secs > PerfResults::MIN_TIME && time_secs < PerfResults::MAX_TIME) {
@@ -89,4 +560,54 @@ void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& p
   }
 
   std::cout << relative_path << ":" << type_test_name << ":" << perf_res_str.str() << std::endl;
+
+  const auto& stat = perfResults->statistics;
+  std::cout << std::scientific << std::setprecision(4) << "Iteration time (secs): min=" << stat.min
+            << " median=" << stat.median << " mean=" << stat.mean << " p95=" << stat.p95 << " p99=" << stat.p99
+            << " max=" << stat.max << " stddev=" << stat.stddev << " outliers=" << stat.num_outliers << "/"
+            << perfResults->samples.size() << std::defaultfloat << std::endl;
+  std::cout << "Iterations: " << perfResults->num_running << (perfResults->calibrated ? " (calibrated)" : "")
+            << std::scientific << std::setprecision(4)
+            << " time per iteration (secs)=" << perfResults->time_per_iteration() << std::defaultfloat << std::endl;
+
+  if (perfResults->type_of_running == PerfResults::TypeOfRunning::PIPELINE) {
+    for (size_t i = 0; i < PerfResults::NUM_PHASES; i++) {
+      const auto& phase = perfResults->phases[i];
+      auto phase_id = static_cast<PerfResults::Phase>(i);
+      auto share = time_secs > 0.0 ? 100.0 * phase.time_sec / time_secs : 0.0;
+      std::cout << std::scientific << std::setprecision(4) << "Phase " << PerfResults::phase_name(phase_id)
+                << " (secs): total=" << phase.time_sec << " mean=" << phase.statistics.mean
+                << " median=" << phase.statistics.median << " p99=" << phase.statistics.p99 << " share=" << std::fixed
+                << std::setprecision(1) << share << "%" << std::defaultfloat << std::endl;
+    }
+  }
+
+  if (!perfResults->ranks.per_rank.empty()) {
+    auto print_ranks = [](const std::string& name, const PerfRankStatistics& ranks) {
+      std::cout << std::scientific << std::setprecision(4) << "Ranks " << name << " (secs): max=" << ranks.max
+                << " min=" << ranks.min << " mean=" << ranks.mean << std::fixed << std::setprecision(3)
+                << " imbalance=" << ranks.imbalance << " slowest_rank=" << ranks.slowest_rank << std::defaultfloat
+                << std::endl;
+    };
+    print_ranks("total", perfResults->ranks);
+    if (perfResults->type_of_running == PerfResults::TypeOfRunning::PIPELINE) {
+      for (size_t i = 0; i < PerfResults::NUM_PHASES; i++) {
+        print_ranks(PerfResults::phase_name(static_cast<PerfResults::Phase>(i)), perfResults->phases[i].ranks);
+      }
+    }
+  }
+
+  const auto& counters = perfResults->counters;
+  if (counters.any_available()) {
+    std::cout << "Counters:";
+    for (size_t i = 0; i < PerfCounterResults::NUM_COUNTERS; i++) {
+      if (counters.available[i]) {
+        std::cout << " " << PerfCounterResults::counter_name(static_cast<PerfCounterResults::Counter>(i)) << "="
+                  << counters.total[i];
+      }
+    }
+    std::cout << std::fixed << std::setprecision(3) << " ipc=" << counters.ipc()
+              << " cache_miss_rate=" << counters.cache_miss_rate() << " branch_mpki=" << counters.branch_mpki()
+              << std::defaultfloat << std::endl;
+  }
 }
@@ -0,0 +1,149 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/perf_baseline.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <utility>
+
+namespace {
+
+void read_threshold(const char* name, double& value) {
+  if (const char* env = std::getenv(name)) {
+    try {
+      auto parsed = std::stod(env);
+      if (std::isfinite(parsed)) {
+        value = parsed;
+      }
+    } catch (const std::exception&) {
+      // ignore malformed value and keep default threshold
+    }
+  }
+}
+
+}  // namespace
+
+ppc::core::PerfRegressionThresholds ppc::core::PerfRegressionThresholds::from_env() {
+  PerfRegressionThresholds thresholds;
+  read_threshold("PPC_PERF_MAX_SLOWDOWN", thresholds.max_slowdown);
+  read_threshold("PPC_PERF_SIGNIFICANCE", thresholds.significance);
+  read_threshold("PPC_PERF_MIN_TIME", thresholds.min_time);
+  return thresholds;
+}
+
+ppc::core::PerfBaseline::PerfBaseline(const std::vector<PerfRecord>& records) {
+  for (const auto& record : records) {
+    this->records[key(record)] = record;
+  }
+}
+
+ppc::core::PerfBaseline ppc::core::PerfBaseline::load(const std::string& path) {
+  return PerfBaseline(read_perf_records(path));
+}
+
+void ppc::core::PerfBaseline::save(const std::string& path) const {
+  std::error_code error;
+  std::filesystem::remove(path, error);
+  std::vector<PerfRecord> stored;
+  stored.reserve(records.size());
+  for (const auto& [record_key, record] : records) {
+    stored.push_back(record);
+  }
+  write_perf_records(path, stored);
+}
+
+std::string ppc::core::PerfBaseline::key(const PerfRecord& record) {
+  auto key = record.task_id + "/" + record.backend + "/" + record.type_of_running + "/" + record.phase + "/" +
+             std::to_string(record.num_threads) + "/" + std::to_string(record.num_processes);
+  // points of sweep run differ by input size only
+  if (record.type_of_running == PerfResults::type_of_running_name(PerfResults::TypeOfRunning::SWEEP)) {
+    key += '/';
+    key += std::to_string(record.input_size);
+  }
+  return key;
+}
+
+const ppc::core::PerfRecord* ppc::core::PerfBaseline::find(const PerfRecord& record) const {
+  auto it = records.find(key(record));
+  return it == records.end() ? nullptr : &it->second;
+}
+
+std::vector<ppc::core::PerfComparison> ppc::core::PerfBaseline::compare(
+    const std::vector<PerfRecord>& current, const PerfRegressionThresholds& thresholds) const {
+  std::vector<PerfComparison> comparisons;
+  for (const auto& record : current) {
+    if (const auto* baseline = find(record)) {
+      comparisons.push_back(compare_perf_record(*baseline, record, thresholds));
+    }
+  }
+  return comparisons;
+}
+
+ppc::core::PerfComparison ppc::core::compare_perf_record(const PerfRecord& baseline, const PerfRecord& current,
+                                                         const PerfRegressionThresholds& thresholds) {
+  PerfComparison comparison;
+  comparison.key = PerfBaseline::key(current);
+  comparison.baseline_median = baseline.statistics.median;
+  comparison.current_median = current.statistics.median;
+  if (comparison.baseline_median > 0.0) {
+    comparison.slowdown = comparison.current_median / comparison.baseline_median - 1.0;
+  }
+  comparison.p_value = mann_whitney_p_value(baseline.samples, current.samples);
+
+  auto enough_samples =
+      baseline.samples.size() >= thresholds.min_samples && current.samples.size() >= thresholds.min_samples;
+  auto significant = !enough_samples || comparison.p_value < thresholds.significance;
+  comparison.regression = comparison.baseline_median >= thresholds.min_time &&
+                          comparison.slowdown > thresholds.max_slowdown && significant;
+  return comparison;
+}
+
+double ppc::core::mann_whitney_p_value(const std::vector<double>& baseline, const std::vector<double>& current) {
+  if (baseline.empty() || current.empty()) {
+    return 1.0;
+  }
+
+  // pooled samples, second is true for current ones
+  std::vector<std::pair<double, bool>> pooled;
+  pooled.reserve(baseline.size() + current.size());
+  for (auto sample : baseline) {
+    pooled.emplace_back(sample, false);
+  }
+  for (auto sample : current) {
+    pooled.emplace_back(sample, true);
+  }
+  std::sort(pooled.begin(), pooled.end());
+
+  // average ranks over runs of ties
+  auto n = static_cast<double>(pooled.size());
+  double current_rank_sum = 0.0;
+  double tie_correction = 0.0;
+  for (size_t begin = 0; begin < pooled.size();) {
+    auto end = begin;
+    while (end < pooled.size() && pooled[end].first == pooled[begin].first) {
+      end++;
+    }
+    auto rank = (static_cast<double>(begin + end) + 1.0) / 2.0;
+    auto ties = static_cast<double>(end - begin);
+    tie_correction += ties * ties * ties - ties;
+    for (auto i = begin; i < end; i++) {
+      if (pooled[i].second) {
+        current_rank_sum += rank;
+      }
+    }
+    begin = end;
+  }
+
+  auto n1 = static_cast<double>(baseline.size());
+  auto n2 = static_cast<double>(current.size());
+  auto u = current_rank_sum - n2 * (n2 + 1.0) / 2.0;
+  auto mean = n1 * n2 / 2.0;
+  auto variance = n1 * n2 / 12.0 * ((n + 1.0) - tie_correction / (n * (n - 1.0)));
+  if (variance <= 0.0) {
+    return 1.0;
+  }
+  auto z = (u - mean - 0.5) / std::sqrt(variance);
+  return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
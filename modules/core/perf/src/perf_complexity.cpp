@@ -0,0 +1,153 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/perf.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+void check_series(const std::vector<uint64_t>& sizes, const std::vector<double>& values) {
+  if (sizes.size() != values.size()) {
+    throw std::invalid_argument("Count of sizes and of measured values differ");
+  }
+}
+
+}  // namespace
+
+const char* ppc::core::PerfComplexityFit::model_name(Model model) {
+  switch (model) {
+    case LINEAR:
+      return "n";
+    case N_LOG_N:
+      return "n_log_n";
+    case QUADRATIC:
+      return "n^2";
+    default:
+      return "none";
+  }
+}
+
+double ppc::core::PerfComplexityFit::model_value(Model model, double size) {
+  switch (model) {
+    case LINEAR:
+      return size;
+    case N_LOG_N:
+      return size * std::log2(size);
+    case QUADRATIC:
+      return size * size;
+    default:
+      return 0.0;
+  }
+}
+
+std::vector<uint64_t> ppc::core::geometric_sizes(uint64_t first, uint64_t last, double factor) {
+  if (first == 0 || factor <= 1.0) {
+    throw std::invalid_argument("Geometric sizes need first size above 0 and factor above 1");
+  }
+  std::vector<uint64_t> sizes;
+  for (auto size = static_cast<double>(first); size <= static_cast<double>(last); size *= factor) {
+    auto rounded = static_cast<uint64_t>(std::llround(size));
+    // small factors may round neighbours to the same size
+    if (sizes.empty() || rounded > sizes.back()) {
+      sizes.push_back(rounded);
+    }
+  }
+  return sizes;
+}
+
+std::vector<ppc::core::PerfComplexityFit> ppc::core::fit_complexity(const std::vector<uint64_t>& sizes,
+                                                                    const std::vector<double>& times) {
+  check_series(sizes, times);
+  std::vector<PerfComplexityFit> fits;
+  for (int i = 0; i < PerfComplexityFit::NUM_MODELS; i++) {
+    PerfComplexityFit fit;
+    fit.model = static_cast<PerfComplexityFit::Model>(i);
+
+    // log t = log c + log g(n), so log c is mean residual of log t against log g(n);
+    // points where either side has no logarithm (n log n of 1, zero time) are left out
+    std::vector<double> log_times;
+    std::vector<double> log_models;
+    for (size_t j = 0; j < sizes.size(); j++) {
+      auto model = PerfComplexityFit::model_value(fit.model, static_cast<double>(sizes[j]));
+      if (model > 0.0 && times[j] > 0.0) {
+        log_times.push_back(std::log(times[j]));
+        log_models.push_back(std::log(model));
+      }
+    }
+    if (!log_times.empty()) {
+      auto count = static_cast<double>(log_times.size());
+      double log_constant = 0.0;
+      double mean_log_time = 0.0;
+      for (size_t j = 0; j < log_times.size(); j++) {
+        log_constant += log_times[j] - log_models[j];
+        mean_log_time += log_times[j];
+      }
+      log_constant /= count;
+      mean_log_time /= count;
+
+      double residual = 0.0;
+      double total = 0.0;
+      for (size_t j = 0; j < log_times.size(); j++) {
+        auto error = log_times[j] - log_models[j] - log_constant;
+        residual += error * error;
+        total += (log_times[j] - mean_log_time) * (log_times[j] - mean_log_time);
+      }
+      fit.constant = std::exp(log_constant);
+      fit.r_squared = total > 0.0 ? 1.0 - residual / total : (residual > 0.0 ? 0.0 : 1.0);
+    }
+    fits.push_back(fit);
+  }
+  std::stable_sort(fits.begin(), fits.end(), [](const PerfComplexityFit& a, const PerfComplexityFit& b) {
+    return a.r_squared > b.r_squared;
+  });
+  return fits;
+}
+
+double ppc::core::fit_complexity_exponent(const std::vector<uint64_t>& sizes, const std::vector<double>& times) {
+  check_series(sizes, times);
+  double count = 0.0;
+  double mean_x = 0.0;
+  double mean_y = 0.0;
+  for (size_t i = 0; i < sizes.size(); i++) {
+    if (sizes[i] > 0 && times[i] > 0.0) {
+      count++;
+      mean_x += std::log(static_cast<double>(sizes[i]));
+      mean_y += std::log(times[i]);
+    }
+  }
+  if (count < 2.0) {
+    return 0.0;
+  }
+  mean_x /= count;
+  mean_y /= count;
+
+  double covariance = 0.0;
+  double variance = 0.0;
+  for (size_t i = 0; i < sizes.size(); i++) {
+    if (sizes[i] > 0 && times[i] > 0.0) {
+      auto x = std::log(static_cast<double>(sizes[i])) - mean_x;
+      covariance += x * (std::log(times[i]) - mean_y);
+      variance += x * x;
+    }
+  }
+  return variance > 0.0 ? covariance / variance : 0.0;
+}
+
+uint64_t ppc::core::find_cache_knee(const std::vector<uint64_t>& sizes, const std::vector<double>& unit_times,
+                                    double threshold) {
+  check_series(sizes, unit_times);
+  // Unit time falls on small sizes while fixed overhead is amortized, so it is compared with the
+  // lowest level reached before rather than with the first point
+  double lowest = 0.0;
+  for (size_t i = 0; i < sizes.size(); i++) {
+    if (unit_times[i] <= 0.0) {
+      continue;
+    }
+    if (lowest > 0.0 && unit_times[i] > threshold * lowest) {
+      return sizes[i];
+    }
+    lowest = lowest > 0.0 ? std::min(lowest, unit_times[i]) : unit_times[i];
+  }
+  return 0;
+}
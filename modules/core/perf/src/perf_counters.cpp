@@ -0,0 +1,106 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/perf_counters.hpp"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <utility>
+#endif
+
+namespace {
+
+#if defined(__linux__)
+constexpr std::array<uint64_t, ppc::core::PerfCounterResults::NUM_COUNTERS> hardware_events = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_REFERENCES};
+
+int open_counter(uint64_t event, pid_t thread_id, int group_fd) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = event;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // user space only keeps counters usable with default perf_event_paranoid
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, thread_id, -1, group_fd, 0));
+}
+
+// Threads of this process, calling thread first
+std::vector<pid_t> process_threads() {
+  auto self = static_cast<pid_t>(syscall(SYS_gettid));
+  std::vector<pid_t> threads = {self};
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task", error)) {
+    auto thread_id = static_cast<pid_t>(std::stol(entry.path().filename().string()));
+    if (thread_id != self) {
+      threads.push_back(thread_id);
+    }
+  }
+  return threads;
+}
+#endif
+
+}  // namespace
+
+ppc::core::PerfCounters::PerfCounters() {
+#if defined(__linux__)
+  for (auto thread_id : process_threads()) {
+    Group group;
+    for (size_t i = 0; i < hardware_events.size(); i++) {
+      auto descriptor = open_counter(hardware_events[i], thread_id, group.leader);
+      if (descriptor < 0) {
+        continue;
+      }
+      if (group.leader < 0) {
+        group.leader = descriptor;
+      }
+      group.descriptors.push_back(descriptor);
+      group.counters.push_back(static_cast<PerfCounterResults::Counter>(i));
+      opened[i] = true;
+    }
+    if (group.leader >= 0) {
+      groups.push_back(std::move(group));
+    }
+  }
+#endif
+}
+
+ppc::core::PerfCounters::~PerfCounters() {
+#if defined(__linux__)
+  for (const auto& group : groups) {
+    for (auto descriptor : group.descriptors) {
+      close(descriptor);
+    }
+  }
+#endif
+}
+
+bool ppc::core::PerfCounters::any_available() const { return !groups.empty(); }
+
+ppc::core::PerfCounterResults::Values ppc::core::PerfCounters::read() const {
+  PerfCounterResults::Values values{};
+#if defined(__linux__)
+  // count of members, time enabled, time running and value of every member
+  std::array<uint64_t, 3 + PerfCounterResults::NUM_COUNTERS> data{};
+  for (const auto& group : groups) {
+    auto size = static_cast<ssize_t>((3 + group.counters.size()) * sizeof(uint64_t));
+    if (::read(group.leader, data.data(), size) != size) {
+      continue;
+    }
+    // members of group are scheduled together, so one scale fits all of them
+    auto scale = data[2] == 0 || data[2] == data[1] ? 1.0 : static_cast<double>(data[1]) / static_cast<double>(data[2]);
+    for (size_t j = 0; j < group.counters.size() && j < data[0]; j++) {
+      values[group.counters[j]] += static_cast<uint64_t>(static_cast<double>(data[3 + j]) * scale);
+    }
+  }
+#endif
+  return values;
+}
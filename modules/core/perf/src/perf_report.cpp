@@ -0,0 +1,397 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/perf_report.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+#ifndef PPC_CXX_FLAGS
+#define PPC_CXX_FLAGS "unknown"
+#endif
+
+#ifndef PPC_GIT_REVISION
+#define PPC_GIT_REVISION "unknown"
+#endif
+
+namespace {
+
+std::string detect_cpu_model() {
+#if defined(__linux__)
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.rfind("model name", 0) == 0) {
+      auto position = line.find(':');
+      auto begin = position != std::string::npos ? line.find_first_not_of(" \t", position + 1) : std::string::npos;
+      // empty model name is reported as unknown
+      if (begin != std::string::npos) {
+        return line.substr(begin);
+      }
+      break;
+    }
+  }
+#elif defined(__APPLE__)
+  char brand[256];
+  size_t size = sizeof(brand);
+  if (sysctlbyname("machdep.cpu.brand_string", brand, &size, nullptr, 0) == 0) {
+    return brand;
+  }
+#endif
+  return "unknown";
+}
+
+std::string detect_compiler() {
+#if defined(__clang__)
+  return "clang " __clang_version__;
+#elif defined(__GNUC__)
+  return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+  return "msvc " + std::to_string(_MSC_VER);
+#else
+  return "unknown";
+#endif
+}
+
+std::string detect_git_revision() {
+  if (const char* revision = std::getenv("PPC_GIT_REVISION")) {
+    return revision;
+  }
+  std::string revision = PPC_GIT_REVISION;
+  return revision.empty() ? "unknown" : revision;
+}
+
+std::string escape_json(const std::string& str) {
+  std::ostringstream out;
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      case '\n':
+        out << "\\n";
+        break;
+      case '\t':
+        out << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+        } else {
+          out << c;
+        }
+    }
+  }
+  return out.str();
+}
+
+std::string escape_csv(const std::string& str) {
+  if (str.find_first_of(",\"\n") == std::string::npos) {
+    return str;
+  }
+  std::string out = "\"";
+  for (char c : str) {
+    if (c == '"') {
+      out += '"';
+    }
+    out += c;
+  }
+  return out + "\"";
+}
+
+void write_json(std::ostream& out, const ppc::core::PerfRecord& record) {
+  const auto& stat = record.statistics;
+  const auto& env = record.environment;
+  out << "{\"task_id\":\"" << escape_json(record.task_id) << "\",\"backend\":\"" << escape_json(record.backend)
+      << "\",\"type_of_running\":\"" << record.type_of_running << "\",\"phase\":\"" << record.phase
+      << "\",\"num_threads\":" << record.num_threads << ",\"num_processes\":" << record.num_processes
+      << ",\"input_size\":" << record.input_size << ",\"speedup\":" << record.speedup
+      << ",\"efficiency\":" << record.efficiency << ",\"samples\":[";
+  for (size_t i = 0; i < record.samples.size(); i++) {
+    out << (i == 0 ? "" : ",") << record.samples[i];
+  }
+  out << "],\"statistics\":{\"min\":" << stat.min << ",\"median\":" << stat.median << ",\"mean\":" << stat.mean
+      << ",\"p95\":" << stat.p95 << ",\"p99\":" << stat.p99 << ",\"max\":" << stat.max << ",\"stddev\":" << stat.stddev
+      << ",\"num_outliers\":" << stat.num_outliers << "},\"environment\":{\"cpu_model\":\""
+      << escape_json(env.cpu_model) << "\",\"compiler\":\"" << escape_json(env.compiler)
+      << "\",\"compiler_flags\":\"" << escape_json(env.compiler_flags) << "\",\"git_revision\":\""
+      << escape_json(env.git_revision) << "\"}}\n";
+}
+
+void write_csv(std::ostream& out, const ppc::core::PerfRecord& record) {
+  const auto& stat = record.statistics;
+  const auto& env = record.environment;
+  out << escape_csv(record.task_id) << "," << escape_csv(record.backend) << "," << record.type_of_running << ","
+      << record.phase << "," << record.num_threads << "," << record.num_processes << "," << record.input_size << ","
+      << record.speedup << "," << record.efficiency << "," << stat.min << "," << stat.median << "," << stat.mean
+      << "," << stat.p95 << "," << stat.p99 << "," << stat.max << "," << stat.stddev << "," << stat.num_outliers
+      << ",";
+  for (size_t i = 0; i < record.samples.size(); i++) {
+    out << (i == 0 ? "" : ";") << record.samples[i];
+  }
+  out << "," << escape_csv(env.cpu_model) << "," << escape_csv(env.compiler) << "," << escape_csv(env.compiler_flags)
+      << "," << escape_csv(env.git_revision) << "\n";
+}
+
+std::vector<std::string> split_csv(const std::string& line) {
+  std::vector<std::string> fields(1);
+  bool quoted = false;
+  for (size_t i = 0; i < line.size(); i++) {
+    char c = line[i];
+    if (quoted) {
+      if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+        fields.back() += '"';
+        i++;
+      } else if (c == '"') {
+        quoted = false;
+      } else {
+        fields.back() += c;
+      }
+    } else if (c == '"') {
+      quoted = true;
+    } else if (c == ',') {
+      fields.emplace_back();
+    } else {
+      fields.back() += c;
+    }
+  }
+  return fields;
+}
+
+std::vector<double> parse_samples(const std::string& str, char delimiter) {
+  std::vector<double> samples;
+  std::istringstream in(str);
+  std::string value;
+  while (std::getline(in, value, delimiter)) {
+    if (!value.empty()) {
+      samples.push_back(std::stod(value));
+    }
+  }
+  return samples;
+}
+
+ppc::core::PerfRecord read_csv(const std::string& line) {
+  auto fields = split_csv(line);
+  if (fields.size() != 22) {
+    throw std::runtime_error("Wrong count of fields in perf report line: " + line);
+  }
+  ppc::core::PerfRecord record;
+  record.task_id = fields[0];
+  record.backend = fields[1];
+  record.type_of_running = fields[2];
+  record.phase = fields[3];
+  record.num_threads = std::stoi(fields[4]);
+  record.num_processes = std::stoi(fields[5]);
+  record.input_size = std::stoull(fields[6]);
+  record.speedup = std::stod(fields[7]);
+  record.efficiency = std::stod(fields[8]);
+  auto& stat = record.statistics;
+  stat.min = std::stod(fields[9]);
+  stat.median = std::stod(fields[10]);
+  stat.mean = std::stod(fields[11]);
+  stat.p95 = std::stod(fields[12]);
+  stat.p99 = std::stod(fields[13]);
+  stat.max = std::stod(fields[14]);
+  stat.stddev = std::stod(fields[15]);
+  stat.num_outliers = std::stoull(fields[16]);
+  record.samples = parse_samples(fields[17], ';');
+  record.environment = {fields[18], fields[19], fields[20], fields[21]};
+  return record;
+}
+
+// Raw text of value after "key": in a line written by write_json, strings are unescaped
+std::string json_value(const std::string& line, const std::string& key) {
+  auto position = line.find("\"" + key + "\":");
+  if (position == std::string::npos) {
+    throw std::runtime_error("No field " + key + " in perf report line: " + line);
+  }
+  position += key.size() + 3;
+  if (line[position] == '[') {
+    return line.substr(position + 1, line.find(']', position) - position - 1);
+  }
+  if (line[position] != '"') {
+    return line.substr(position, line.find_first_of(",}", position) - position);
+  }
+  std::string value;
+  for (size_t i = position + 1; i < line.size() && line[i] != '"'; i++) {
+    if (line[i] == '\\' && i + 1 < line.size()) {
+      char c = line[++i];
+      if (c == 'n') {
+        value += '\n';
+      } else if (c == 't') {
+        value += '\t';
+      } else if (c == 'u' && i + 4 < line.size()) {
+        value += static_cast<char>(std::stoi(line.substr(i + 1, 4), nullptr, 16));
+        i += 4;
+      } else {
+        value += c;
+      }
+    } else {
+      value += line[i];
+    }
+  }
+  return value;
+}
+
+ppc::core::PerfRecord read_json(const std::string& line) {
+  ppc::core::PerfRecord record;
+  record.task_id = json_value(line, "task_id");
+  record.backend = json_value(line, "backend");
+  record.type_of_running = json_value(line, "type_of_running");
+  record.phase = json_value(line, "phase");
+  record.num_threads = std::stoi(json_value(line, "num_threads"));
+  record.num_processes = std::stoi(json_value(line, "num_processes"));
+  record.input_size = std::stoull(json_value(line, "input_size"));
+  record.speedup = std::stod(json_value(line, "speedup"));
+  record.efficiency = std::stod(json_value(line, "efficiency"));
+  record.samples = parse_samples(json_value(line, "samples"), ',');
+  auto& stat = record.statistics;
+  stat.min = std::stod(json_value(line, "min"));
+  stat.median = std::stod(json_value(line, "median"));
+  stat.mean = std::stod(json_value(line, "mean"));
+  stat.p95 = std::stod(json_value(line, "p95"));
+  stat.p99 = std::stod(json_value(line, "p99"));
+  stat.max = std::stod(json_value(line, "max"));
+  stat.stddev = std::stod(json_value(line, "stddev"));
+  stat.num_outliers = std::stoull(json_value(line, "num_outliers"));
+  record.environment = {json_value(line, "cpu_model"), json_value(line, "compiler"),
+                        json_value(line, "compiler_flags"), json_value(line, "git_revision")};
+  return record;
+}
+
+constexpr const char* csv_header =
+    "task_id,backend,type_of_running,phase,num_threads,num_processes,input_size,speedup,efficiency,"
+    "min,median,mean,p95,p99,max,stddev,num_outliers,samples,cpu_model,compiler,compiler_flags,git_revision\n";
+
+}  // namespace
+
+const ppc::core::PerfEnvironment& ppc::core::PerfEnvironment::current() {
+  static const PerfEnvironment environment{detect_cpu_model(), detect_compiler(), PPC_CXX_FLAGS,
+                                           detect_git_revision()};
+  return environment;
+}
+
+std::vector<ppc::core::PerfRecord> ppc::core::make_perf_records(const PerfResults& perfResults) {
+  PerfRecord common;
+  common.task_id = perfResults.task_id;
+  common.backend = perfResults.backend;
+  common.type_of_running = PerfResults::type_of_running_name(perfResults.type_of_running);
+  common.num_threads = perfResults.num_threads;
+  common.num_processes = perfResults.num_processes;
+  common.input_size = perfResults.input_size;
+  common.environment = PerfEnvironment::current();
+
+  std::vector<PerfRecord> records;
+  if (perfResults.type_of_running == PerfResults::TypeOfRunning::SCALING) {
+    for (const auto& point : perfResults.scaling) {
+      auto record = common;
+      record.phase = "total";
+      record.num_threads = point.num_threads;
+      record.speedup = point.speedup;
+      record.efficiency = point.efficiency;
+      record.samples = point.samples;
+      record.statistics = point.statistics;
+      records.push_back(std::move(record));
+    }
+    return records;
+  }
+  if (perfResults.type_of_running == PerfResults::TypeOfRunning::SWEEP) {
+    for (const auto& point : perfResults.sweep) {
+      auto record = common;
+      record.phase = "run";
+      record.input_size = point.size;
+      record.samples = point.samples;
+      record.statistics = point.statistics;
+      records.push_back(std::move(record));
+    }
+    return records;
+  }
+
+  auto total = common;
+  total.phase = "total";
+  total.samples = perfResults.samples;
+  total.statistics = perfResults.statistics;
+  records.push_back(std::move(total));
+
+  if (perfResults.type_of_running == PerfResults::TypeOfRunning::PIPELINE) {
+    for (size_t i = 0; i < PerfResults::NUM_PHASES; i++) {
+      auto record = common;
+      record.phase = PerfResults::phase_name(static_cast<PerfResults::Phase>(i));
+      record.samples = perfResults.phases[i].samples;
+      record.statistics = perfResults.phases[i].statistics;
+      records.push_back(std::move(record));
+    }
+  }
+  return records;
+}
+
+void ppc::core::write_perf_records(const std::string& path, const std::vector<PerfRecord>& records) {
+  auto is_csv = std::filesystem::path(path).extension() == ".csv";
+  std::error_code error;
+  auto is_new_file = !std::filesystem::exists(path, error) || std::filesystem::file_size(path, error) == 0;
+
+  std::ofstream out(path, std::ios::app);
+  if (!out) {
+    throw std::runtime_error("Can't open perf report file: " + path);
+  }
+  out << std::setprecision(10);
+  if (is_csv && is_new_file) {
+    out << csv_header;
+  }
+  for (const auto& record : records) {
+    if (is_csv) {
+      write_csv(out, record);
+    } else {
+      write_json(out, record);
+    }
+  }
+}
+
+std::pair<std::string, std::string> ppc::core::task_id_from_path(const std::string& path) {
+  std::vector<std::string> parts;
+  std::string part;
+  for (char c : path) {
+    if (c == '/' || c == '\\') {
+      parts.push_back(part);
+      part.clear();
+    } else {
+      part += c;
+    }
+  }
+  parts.push_back(part);
+
+  for (size_t i = parts.size(); i-- > 0;) {
+    if (parts[i] == "tasks" && i + 2 < parts.size()) {
+      return {parts[i + 2], parts[i + 1]};
+    }
+  }
+  return {"unknown", "unknown"};
+}
+
+std::vector<ppc::core::PerfRecord> ppc::core::read_perf_records(const std::string& path) {
+  std::ifstream in(path);
+  if (!in) {
+    throw std::runtime_error("Can't open perf report file: " + path);
+  }
+  auto is_csv = std::filesystem::path(path).extension() == ".csv";
+  std::vector<PerfRecord> records;
+  std::string line;
+  bool is_header = is_csv;
+  while (std::getline(in, line)) {
+    if (line.empty() || is_header) {
+      is_header = false;
+      continue;
+    }
+    records.push_back(is_csv ? read_csv(line) : read_json(line));
+  }
+  return records;
+}
@@ -0,0 +1,54 @@
+// Copyright 2024 Nesterov Alexander
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "core/perf/include/perf_baseline.hpp"
+
+// Compare perf report with baseline one, exit code is 1 if any series regressed.
+// Usage: perf_compare <baseline report> <current report> [--max-slowdown=X] [--significance=P] [--min-time=S]
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0]
+              << " <baseline report> <current report> [--max-slowdown=X] [--significance=P] [--min-time=S]"
+              << std::endl;
+    return 2;
+  }
+
+  try {
+    auto thresholds = ppc::core::PerfRegressionThresholds::from_env();
+    for (int i = 3; i < argc; i++) {
+      std::string arg(argv[i]);
+      auto value = arg.substr(arg.find('=') + 1);
+      if (arg.rfind("--max-slowdown=", 0) == 0) {
+        thresholds.max_slowdown = std::stod(value);
+      } else if (arg.rfind("--significance=", 0) == 0) {
+        thresholds.significance = std::stod(value);
+      } else if (arg.rfind("--min-time=", 0) == 0) {
+        thresholds.min_time = std::stod(value);
+      } else {
+        std::cerr << "Unknown option: " << arg << std::endl;
+        return 2;
+      }
+    }
+
+    auto baseline = ppc::core::PerfBaseline::load(argv[1]);
+    auto comparisons = baseline.compare(ppc::core::read_perf_records(argv[2]), thresholds);
+
+    int num_regressions = 0;
+    for (const auto& comparison : comparisons) {
+      std::cout << (comparison.regression ? "REGRESSION " : "ok         ") << comparison.key << std::scientific
+                << std::setprecision(4) << " median=" << comparison.baseline_median << " -> "
+                << comparison.current_median << std::fixed << std::setprecision(1)
+                << " slowdown=" << 100.0 * comparison.slowdown << "%" << std::setprecision(4)
+                << " p=" << comparison.p_value << std::endl;
+      num_regressions += comparison.regression ? 1 : 0;
+    }
+    std::cout << comparisons.size() << " series compared, " << num_regressions << " regressed" << std::endl;
+    return num_regressions == 0 ? 0 : 1;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  }
+}
@@ -0,0 +1,76 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "core/random/include/random.hpp"
+
+TEST(random_tests, check_same_seed_gives_same_values) {
+  auto values = ppc::core::random_vector<int>(1000, 0, 99, 7);
+  EXPECT_EQ(ppc::core::random_vector<int>(1000, 0, 99, 7), values);
+  EXPECT_NE(ppc::core::random_vector<int>(1000, 0, 99, 8), values);
+}
+
+TEST(random_tests, check_values_dont_depend_on_threads) {
+  const size_t size = 100000;
+  std::vector<double> expected(size);
+  ppc::core::fill_uniform(std::span<double>(expected), -1.0, 1.0, 42, 0, 1);
+  for (int num_threads : {2, 3, 8}) {
+    std::vector<double> values(size);
+    ppc::core::fill_uniform(std::span<double>(values), -1.0, 1.0, 42, 0, num_threads);
+    EXPECT_EQ(values, expected) << num_threads << " threads";
+  }
+}
+
+TEST(random_tests, check_offset_generates_block_of_stream) {
+  auto whole = ppc::core::random_vector<int64_t>(1000, -5, 5, 3);
+  auto block = ppc::core::random_vector<int64_t>(300, -5, 5, 3, 250);
+  EXPECT_TRUE(std::equal(block.begin(), block.end(), whole.begin() + 250));
+}
+
+TEST(random_tests, check_integers_cover_inclusive_range) {
+  auto values = ppc::core::random_vector<int>(10000, -3, 3, 1);
+  std::vector<int> counts(7, 0);
+  for (auto value : values) {
+    ASSERT_GE(value, -3);
+    ASSERT_LE(value, 3);
+    counts[value + 3]++;
+  }
+  for (auto count : counts) {
+    // 10000 / 7 is about 1429
+    EXPECT_GT(count, 1200);
+    EXPECT_LT(count, 1650);
+  }
+}
+
+TEST(random_tests, check_full_ranges) {
+  auto bytes = ppc::core::random_vector<uint8_t>(10000, 0, 255, 5);
+  EXPECT_EQ(*std::max_element(bytes.begin(), bytes.end()), 255);
+  EXPECT_EQ(*std::min_element(bytes.begin(), bytes.end()), 0);
+  auto limits = std::numeric_limits<int64_t>();
+  auto wide = ppc::core::random_vector<int64_t>(1000, limits.min(), limits.max(), 5);
+  EXPECT_TRUE(std::any_of(wide.begin(), wide.end(), [](int64_t value) { return value < 0; }));
+  EXPECT_TRUE(std::any_of(wide.begin(), wide.end(), [](int64_t value) { return value > 0; }));
+}
+
+TEST(random_tests, check_floating_point_range_and_mean) {
+  auto values = ppc::core::random_vector<float>(100000, 2.0F, 4.0F, 9);
+  for (auto value : values) {
+    ASSERT_GE(value, 2.0F);
+    ASSERT_LT(value, 4.0F);
+  }
+  auto mean = std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+  EXPECT_NEAR(mean, 3.0, 0.02);
+}
+
+TEST(random_tests, check_upper_bound_is_excluded) {
+  // unit value closest to 1 rounds to high in float arithmetic
+  ppc::core::UniformDistribution<float> distribution(2.0F, 4.0F);
+  EXPECT_LT(distribution(std::numeric_limits<uint64_t>::max()), 4.0F);
+  EXPECT_EQ(distribution(0), 2.0F);
+}
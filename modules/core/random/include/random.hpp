@@ -0,0 +1,121 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_RANDOM_HPP_
+#define MODULES_CORE_INCLUDE_RANDOM_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "core/threading/include/thread_pool.hpp"
+#include "core/threading/include/threading.hpp"
+
+namespace ppc::core {
+
+// Seed of generated inputs: PPC_SEED environment variable if it is set, otherwise a fixed value,
+// so inputs are the same from run to run unless asked otherwise
+uint64_t default_seed();
+
+// Counter-based generator: value number counter of stream seed is a pure function of both
+// (SplitMix64 finalizer of seed key plus counter times golden ratio gamma). There is no state to
+// advance, so any slice of a stream is generated independently by any thread or rank.
+class CounterRng {
+ public:
+  explicit constexpr CounterRng(uint64_t seed) : key_(mix(seed)) {}
+
+  [[nodiscard]] constexpr uint64_t operator()(uint64_t counter) const { return mix(key_ + (counter + 1) * kGamma); }
+
+  static constexpr uint64_t mix(uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+  }
+
+ private:
+  static constexpr uint64_t kGamma = 0x9e3779b97f4a7c15ULL;
+  uint64_t key_;
+};
+
+namespace detail {
+
+// High 64 bits of 128-bit product, portable to compilers without __int128
+constexpr uint64_t multiply_high(uint64_t lhs, uint64_t rhs) {
+  auto lhs_low = lhs & 0xffffffffULL;
+  auto lhs_high = lhs >> 32;
+  auto rhs_low = rhs & 0xffffffffULL;
+  auto rhs_high = rhs >> 32;
+  auto low_low = lhs_low * rhs_low;
+  auto high_low = lhs_high * rhs_low;
+  auto low_high = lhs_low * rhs_high;
+  auto middle = (low_low >> 32) + (high_low & 0xffffffffULL) + low_high;
+  return lhs_high * rhs_high + (high_low >> 32) + (middle >> 32);
+}
+
+}  // namespace detail
+
+// Maps 64 random bits to a value of T: integers uniformly in [low, high] (both inclusive) by
+// multiply-shift range reduction, floating point values uniformly in [low, high)
+template <class T>
+class UniformDistribution {
+  static_assert(std::is_arithmetic_v<T>, "UniformDistribution needs an arithmetic type");
+
+ public:
+  constexpr UniformDistribution(T low, T high) : low_(low), high_(high) {}
+
+  [[nodiscard]] T operator()(uint64_t bits) const {
+    if constexpr (std::is_floating_point_v<T>) {
+      constexpr int digits = std::min(std::numeric_limits<T>::digits, 53);
+      auto unit = static_cast<T>(bits >> (64 - digits)) / static_cast<T>(uint64_t{1} << digits);
+      // rounding may reach high for wide ranges, the largest value below it is returned then
+      auto value = low_ + (high_ - low_) * unit;
+      return value < high_ ? value : std::nextafter(high_, low_);
+    } else {
+      // count of values in range, 0 stands for all 2^64 values
+      auto range = static_cast<uint64_t>(high_) - static_cast<uint64_t>(low_) + 1;
+      auto offset = range == 0 ? bits : detail::multiply_high(bits, range);
+      return static_cast<T>(static_cast<uint64_t>(low_) + offset);
+    }
+  }
+
+ private:
+  T low_;
+  T high_;
+};
+
+// out[i] = value number offset + i of stream seed, so result doesn't depend on count of threads and
+// a block of a larger input (e.g. block of MPI rank) is generated alone by passing its offset.
+// Large buffers are filled on global ThreadPool.
+template <class T>
+void fill_uniform(std::span<T> out, T low, T high, uint64_t seed, uint64_t offset = 0,
+                  int num_threads = get_num_threads()) {
+  const CounterRng rng(seed);
+  const UniformDistribution<T> distribution(low, high);
+  auto fill = [&](size_t begin, size_t end) {
+    for (auto i = begin; i < end; i++) {
+      out[i] = distribution(rng(offset + i));
+    }
+  };
+  // below this size waking workers costs more than generating values
+  constexpr size_t kMinParallelSize = size_t{1} << 15;
+  if (out.size() < kMinParallelSize) {
+    fill(0, out.size());
+    return;
+  }
+  ThreadPool::global().parallel_for(size_t{0}, out.size(), fill, num_threads);
+}
+
+template <class T>
+std::vector<T> random_vector(size_t size, T low, T high, uint64_t seed = default_seed(), uint64_t offset = 0) {
+  std::vector<T> values(size);
+  fill_uniform(std::span<T>(values), low, high, seed, offset);
+  return values;
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_RANDOM_HPP_
@@ -0,0 +1,17 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/random/include/random.hpp"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+uint64_t ppc::core::default_seed() {
+  if (const char* env = std::getenv("PPC_SEED")) {
+    try {
+      return std::stoull(env);
+    } catch (const std::exception&) {
+      // ignore malformed value and fall back to fixed seed
+    }
+  }
+  return 2024;
+}
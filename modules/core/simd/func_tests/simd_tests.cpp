@@ -0,0 +1,132 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "core/simd/include/simd.hpp"
+
+namespace {
+
+using ppc::core::simd::InstructionSet;
+
+// Run check with every instruction set CPU supports, from scalar up
+template <typename Check>
+void for_each_instruction_set(Check check) {
+  auto initial = ppc::core::simd::instruction_set();
+  for (auto instruction_set :
+       {InstructionSet::SCALAR, InstructionSet::SSE, InstructionSet::AVX2, InstructionSet::AVX512}) {
+    if (instruction_set > ppc::core::simd::supported_instruction_set()) {
+      break;
+    }
+    ppc::core::simd::set_instruction_set(instruction_set);
+    SCOPED_TRACE(ppc::core::simd::instruction_set_name(instruction_set));
+    check();
+  }
+  ppc::core::simd::set_instruction_set(initial);
+}
+
+template <typename T>
+std::vector<T> random_values(size_t size, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(-100, 100);
+  std::vector<T> values(size);
+  for (auto& value : values) {
+    value = static_cast<T>(std::is_signed_v<T> ? dist(gen) : std::abs(dist(gen)));
+  }
+  return values;
+}
+
+// Sizes around multiples of vector length times accumulators, views start at unaligned offsets
+const std::vector<size_t> sizes = {0, 1, 3, 7, 15, 16, 17, 31, 63, 64, 65, 127, 255, 256, 1000, 4099};
+
+template <typename T>
+void check_reductions() {
+  for_each_instruction_set([] {
+    for (auto size : sizes) {
+      auto values = random_values<T>(size + 1, static_cast<unsigned>(size));
+      auto other = random_values<T>(size + 1, static_cast<unsigned>(size) + 1);
+      std::span<const T> view(values.data() + 1, size);
+      std::span<const T> other_view(other.data() + 1, size);
+
+      using Acc = ppc::core::simd::accumulator_t<T>;
+      auto expected_sum = std::accumulate(view.begin(), view.end(), Acc{});
+      auto expected_dot = std::inner_product(view.begin(), view.end(), other_view.begin(), Acc{});
+      if constexpr (std::is_floating_point_v<T>) {
+        EXPECT_NEAR(ppc::core::simd::sum(view), expected_sum, 1e-3);
+        EXPECT_NEAR(ppc::core::simd::dot(view, other_view), expected_dot, 1e-2);
+      } else {
+        EXPECT_EQ(ppc::core::simd::sum(view), expected_sum);
+        EXPECT_EQ(ppc::core::simd::dot(view, other_view), expected_dot);
+      }
+
+      auto expected_min = std::min_element(view.begin(), view.end()) - view.begin();
+      auto expected_max = std::max_element(view.begin(), view.end()) - view.begin();
+      EXPECT_EQ(ppc::core::simd::min_index(view), static_cast<size_t>(expected_min)) << "size " << size;
+      EXPECT_EQ(ppc::core::simd::max_index(view), static_cast<size_t>(expected_max)) << "size " << size;
+    }
+  });
+}
+
+}  // namespace
+
+TEST(simd_tests, check_int8_t) { check_reductions<int8_t>(); }
+
+TEST(simd_tests, check_uint8_t) { check_reductions<uint8_t>(); }
+
+TEST(simd_tests, check_int32_t) { check_reductions<int32_t>(); }
+
+TEST(simd_tests, check_int64_t) { check_reductions<int64_t>(); }
+
+TEST(simd_tests, check_float) { check_reductions<float>(); }
+
+TEST(simd_tests, check_double) { check_reductions<double>(); }
+
+TEST(simd_tests, check_wider_accumulator) {
+  std::vector<int32_t> values(1000, std::numeric_limits<int32_t>::max());
+  std::vector<float> fractions(1000, 0.1F);
+  for_each_instruction_set([&] {
+    EXPECT_EQ(ppc::core::simd::sum(std::span<const int32_t>(values)),
+              int64_t{1000} * std::numeric_limits<int32_t>::max());
+    EXPECT_NEAR(ppc::core::simd::sum<double>(std::span<const float>(fractions)), 100.0, 1e-4);
+  });
+}
+
+TEST(simd_tests, check_first_extremum_is_found) {
+  std::vector<double> values(300, 0.0);
+  values[37] = values[150] = values[299] = -1.0;
+  values[5] = values[100] = 2.0;
+  for_each_instruction_set([&] {
+    EXPECT_EQ(ppc::core::simd::min_index(std::span<const double>(values)), 37u);
+    EXPECT_EQ(ppc::core::simd::max_index(std::span<const double>(values)), 5u);
+  });
+}
+
+TEST(simd_tests, check_nan_like_std_min_element) {
+  auto nan = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> leading(100, 1.0);
+  leading[0] = nan;
+  leading[50] = -1.0;
+  std::vector<double> inner(100, 1.0);
+  inner[10] = nan;
+  inner[70] = -1.0;
+  for_each_instruction_set([&] {
+    EXPECT_EQ(ppc::core::simd::min_index(std::span<const double>(leading)), 0u);
+    EXPECT_EQ(ppc::core::simd::min_index(std::span<const double>(inner)), 70u);
+    EXPECT_EQ(ppc::core::simd::max_index(std::span<const double>(inner)), 0u);
+  });
+}
+
+TEST(simd_tests, check_instruction_set_is_capped) {
+  auto initial = ppc::core::simd::instruction_set();
+  EXPECT_EQ(ppc::core::simd::set_instruction_set(InstructionSet::AVX512), ppc::core::simd::supported_instruction_set());
+  EXPECT_EQ(ppc::core::simd::set_instruction_set(InstructionSet::SCALAR), InstructionSet::SCALAR);
+  EXPECT_EQ(ppc::core::simd::instruction_set(), InstructionSet::SCALAR);
+  ppc::core::simd::set_instruction_set(initial);
+}
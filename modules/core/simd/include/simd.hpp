@@ -0,0 +1,309 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_SIMD_HPP_
+#define MODULES_CORE_INCLUDE_SIMD_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <type_traits>
+
+#if defined(__GNUC__)
+#define PPC_SIMD_VECTOR_EXTENSIONS 1
+#if defined(__x86_64__) || defined(__i386__)
+#define PPC_SIMD_X86 1
+#endif
+#endif
+
+namespace ppc::core::simd {
+
+// Instruction sets kernels are compiled for, every one includes previous ones
+enum class InstructionSet : uint8_t { SCALAR, SSE, AVX2, AVX512 };
+
+const char* instruction_set_name(InstructionSet instruction_set);
+
+// Widest instruction set of CPU the kernels are compiled for
+InstructionSet supported_instruction_set();
+
+// Instruction set used by kernels, supported one unless lowered by PPC_SIMD environment
+// variable (scalar, sse, avx2, avx512) or set_instruction_set
+InstructionSet instruction_set();
+
+// Lower instruction set (for testing and comparison), capped by supported one; returns set in use
+InstructionSet set_instruction_set(InstructionSet instruction_set);
+
+// Accumulator which sums many values of T without overflow, floating point values are summed in their own type
+template <typename T>
+using accumulator_t =
+    std::conditional_t<std::is_floating_point_v<T>, T, std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+namespace detail {
+
+// Kernels are written once over vectors of Lanes values (GCC/Clang vector extensions) and compiled
+// for every instruction set by inlining into functions with target attribute. Several independent
+// accumulators hide latency of additions, so loop is limited by loads rather than by dependency chain.
+inline constexpr size_t num_accumulators = 4;
+
+template <typename T, size_t Lanes>
+struct VectorOf {
+#if defined(PPC_SIMD_VECTOR_EXTENSIONS)
+  using type [[gnu::vector_size(sizeof(T) * Lanes)]] = T;
+#endif
+};
+
+template <typename T>
+struct VectorOf<T, 1> {
+  using type = T;
+};
+
+template <typename T, size_t Lanes>
+using Vector = typename VectorOf<T, Lanes>::type;
+
+// Vector of Bytes (one value if Bytes is 0 or too small)
+template <typename T, size_t Bytes>
+inline constexpr size_t lanes = std::max<size_t>(1, Bytes / sizeof(T));
+
+#if defined(__GNUC__)
+#define PPC_SIMD_INLINE [[gnu::always_inline]] inline
+#else
+#define PPC_SIMD_INLINE inline
+#endif
+
+// Helpers write vectors to references: vectors passed by value would depend on ABI of instruction set
+template <typename T, size_t Lanes>
+PPC_SIMD_INLINE void load(Vector<T, Lanes>& value, const T* data) {
+  std::memcpy(&value, data, sizeof(value));
+}
+
+// Load Lanes values of T and widen them to To
+template <typename To, typename T, size_t Lanes>
+PPC_SIMD_INLINE void load_as(Vector<To, Lanes>& value, const T* data) {
+  if constexpr (Lanes == 1) {
+    value = static_cast<To>(*data);
+  } else {
+    Vector<T, Lanes> loaded;
+    load<T, Lanes>(loaded, data);
+    value = __builtin_convertvector(loaded, Vector<To, Lanes>);
+  }
+}
+
+template <typename T, size_t Lanes>
+PPC_SIMD_INLINE void broadcast(Vector<T, Lanes>& value, T scalar) {
+  if constexpr (Lanes == 1) {
+    value = scalar;
+  } else {
+    value = Vector<T, Lanes>{} + scalar;
+  }
+}
+
+template <size_t Lanes, typename V, typename Op>
+PPC_SIMD_INLINE auto horizontal(const V& value, Op op) {
+  if constexpr (Lanes == 1) {
+    return value;
+  } else {
+    auto result = value[0];
+    for (size_t lane = 1; lane < Lanes; lane++) {
+      result = op(result, value[lane]);
+    }
+    return result;
+  }
+}
+
+template <typename Acc, typename T>
+struct SumKernel {
+  template <size_t Bytes>
+  PPC_SIMD_INLINE static Acc run(const T* data, size_t size) {
+    constexpr auto L = lanes<Acc, Bytes>;
+    constexpr auto step = L * num_accumulators;
+    Vector<Acc, L> acc[num_accumulators]{};
+    auto body = size - size % step;
+    for (size_t i = 0; i < body; i += step) {
+      for (size_t k = 0; k < num_accumulators; k++) {
+        Vector<Acc, L> value;
+        load_as<Acc, T, L>(value, data + i + k * L);
+        acc[k] += value;
+      }
+    }
+    for (size_t k = 1; k < num_accumulators; k++) {
+      acc[0] += acc[k];
+    }
+    auto result = horizontal<L>(acc[0], std::plus<>());
+    for (auto i = body; i < size; i++) {
+      result += static_cast<Acc>(data[i]);
+    }
+    return result;
+  }
+};
+
+template <typename Acc, typename T>
+struct DotKernel {
+  template <size_t Bytes>
+  PPC_SIMD_INLINE static Acc run(const T* lhs, const T* rhs, size_t size) {
+    constexpr auto L = lanes<Acc, Bytes>;
+    constexpr auto step = L * num_accumulators;
+    Vector<Acc, L> acc[num_accumulators]{};
+    auto body = size - size % step;
+    for (size_t i = 0; i < body; i += step) {
+      for (size_t k = 0; k < num_accumulators; k++) {
+        Vector<Acc, L> left;
+        Vector<Acc, L> right;
+        load_as<Acc, T, L>(left, lhs + i + k * L);
+        load_as<Acc, T, L>(right, rhs + i + k * L);
+        acc[k] += left * right;
+      }
+    }
+    for (size_t k = 1; k < num_accumulators; k++) {
+      acc[0] += acc[k];
+    }
+    auto result = horizontal<L>(acc[0], std::plus<>());
+    for (auto i = body; i < size; i++) {
+      result += static_cast<Acc>(lhs[i]) * static_cast<Acc>(rhs[i]);
+    }
+    return result;
+  }
+};
+
+// Smallest (or largest) value, size has to be positive. Like std::min_element, a value replaces
+// the current one only if it is strictly better, so NaN never replaces a number
+template <typename T, bool Largest>
+struct ExtremumKernel {
+  template <size_t Bytes>
+  PPC_SIMD_INLINE static T run(const T* data, size_t size) {
+    constexpr auto L = lanes<T, Bytes>;
+    constexpr auto step = L * num_accumulators;
+    Vector<T, L> acc[num_accumulators];
+    for (auto& partial : acc) {
+      broadcast<T, L>(partial, data[0]);
+    }
+    auto body = size - size % step;
+    for (size_t i = 0; i < body; i += step) {
+      for (size_t k = 0; k < num_accumulators; k++) {
+        Vector<T, L> value;
+        load<T, L>(value, data + i + k * L);
+        if constexpr (Largest) {
+          acc[k] = value > acc[k] ? value : acc[k];
+        } else {
+          acc[k] = value < acc[k] ? value : acc[k];
+        }
+      }
+    }
+    auto pick = [](T lhs, T rhs) { return (Largest ? rhs > lhs : rhs < lhs) ? rhs : lhs; };
+    auto result = data[0];
+    for (size_t k = 0; k < num_accumulators; k++) {
+      result = pick(result, horizontal<L>(acc[k], pick));
+    }
+    for (auto i = body; i < size; i++) {
+      result = pick(result, data[i]);
+    }
+    return result;
+  }
+};
+
+// Index of first element equal to value, size if there is none
+template <typename T>
+struct FindKernel {
+  template <size_t Bytes>
+  PPC_SIMD_INLINE static size_t run(const T* data, size_t size, T value) {
+    constexpr auto L = lanes<T, Bytes>;
+    Vector<T, L> target;
+    broadcast<T, L>(target, value);
+    auto body = size - size % L;
+    size_t i = 0;
+    for (; i < body; i += L) {
+      Vector<T, L> loaded;
+      load<T, L>(loaded, data + i);
+      if (horizontal<L>(loaded == target, std::bit_or<>())) {
+        break;
+      }
+    }
+    for (; i < size; i++) {
+      if (data[i] == value) {
+        return i;
+      }
+    }
+    return size;
+  }
+};
+
+#if defined(PPC_SIMD_X86)
+template <typename Kernel, typename... Args>
+[[gnu::target("avx512f,avx512dq,avx512bw,avx512vl")]] auto run_avx512(Args... args) {
+  return Kernel::template run<64>(args...);
+}
+
+template <typename Kernel, typename... Args>
+[[gnu::target("avx2,fma")]] auto run_avx2(Args... args) {
+  return Kernel::template run<32>(args...);
+}
+
+template <typename Kernel, typename... Args>
+[[gnu::target("sse4.2")]] auto run_sse(Args... args) {
+  return Kernel::template run<16>(args...);
+}
+#endif
+
+// Run kernel compiled for current instruction set
+template <typename Kernel, typename... Args>
+auto dispatch(Args... args) {
+#if defined(PPC_SIMD_X86)
+  switch (instruction_set()) {
+    case InstructionSet::AVX512:
+      return run_avx512<Kernel>(args...);
+    case InstructionSet::AVX2:
+      return run_avx2<Kernel>(args...);
+    case InstructionSet::SSE:
+      return run_sse<Kernel>(args...);
+    case InstructionSet::SCALAR:
+      break;
+  }
+#endif
+  return Kernel::template run<0>(args...);
+}
+
+#undef PPC_SIMD_INLINE
+
+}  // namespace detail
+
+// Sum of values, accumulated in Acc (accumulator_t<T> by default)
+template <typename Acc = void, typename T>
+auto sum(std::span<const T> values) {
+  using Accumulator = std::conditional_t<std::is_void_v<Acc>, accumulator_t<T>, Acc>;
+  return detail::dispatch<detail::SumKernel<Accumulator, T>>(values.data(), values.size());
+}
+
+// Dot product of lhs and first lhs.size() values of rhs, accumulated in Acc (accumulator_t<T> by default)
+template <typename Acc = void, typename T>
+auto dot(std::span<const T> lhs, std::span<const T> rhs) {
+  using Accumulator = std::conditional_t<std::is_void_v<Acc>, accumulator_t<T>, Acc>;
+  return detail::dispatch<detail::DotKernel<Accumulator, T>>(lhs.data(), rhs.data(), lhs.size());
+}
+
+// Index of first smallest value as std::min_element gives, size of values (no element) if empty
+template <typename T>
+size_t min_index(std::span<const T> values) {
+  if (values.empty()) {
+    return values.size();
+  }
+  auto value = detail::dispatch<detail::ExtremumKernel<T, false>>(values.data(), values.size());
+  auto index = detail::dispatch<detail::FindKernel<T>>(values.data(), values.size(), value);
+  // value is not equal to itself only if it is NaN at the front
+  return index < values.size() ? index : 0;
+}
+
+// Index of first largest value as std::max_element gives, size of values (no element) if empty
+template <typename T>
+size_t max_index(std::span<const T> values) {
+  if (values.empty()) {
+    return values.size();
+  }
+  auto value = detail::dispatch<detail::ExtremumKernel<T, true>>(values.data(), values.size());
+  auto index = detail::dispatch<detail::FindKernel<T>>(values.data(), values.size(), value);
+  return index < values.size() ? index : 0;
+}
+
+}  // namespace ppc::core::simd
+
+#endif  // MODULES_CORE_INCLUDE_SIMD_HPP_
@@ -0,0 +1,76 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/simd/include/simd.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+using ppc::core::simd::InstructionSet;
+
+InstructionSet detect_instruction_set() {
+#if defined(PPC_SIMD_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+      __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl")) {
+    return InstructionSet::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return InstructionSet::AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return InstructionSet::SSE;
+  }
+#endif
+  return InstructionSet::SCALAR;
+}
+
+InstructionSet default_instruction_set() {
+  auto supported = ppc::core::simd::supported_instruction_set();
+  if (const char* env = std::getenv("PPC_SIMD")) {
+    std::string name(env);
+    for (auto candidate : {InstructionSet::SCALAR, InstructionSet::SSE, InstructionSet::AVX2, InstructionSet::AVX512}) {
+      if (name == ppc::core::simd::instruction_set_name(candidate)) {
+        return std::min(candidate, supported);
+      }
+    }
+  }
+  return supported;
+}
+
+std::atomic<InstructionSet>& current_instruction_set() {
+  static std::atomic<InstructionSet> instruction_set{default_instruction_set()};
+  return instruction_set;
+}
+
+}  // namespace
+
+const char* ppc::core::simd::instruction_set_name(InstructionSet instruction_set) {
+  switch (instruction_set) {
+    case InstructionSet::SCALAR:
+      return "scalar";
+    case InstructionSet::SSE:
+      return "sse";
+    case InstructionSet::AVX2:
+      return "avx2";
+    case InstructionSet::AVX512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+ppc::core::simd::InstructionSet ppc::core::simd::supported_instruction_set() {
+  static const auto supported = detect_instruction_set();
+  return supported;
+}
+
+ppc::core::simd::InstructionSet ppc::core::simd::instruction_set() {
+  return current_instruction_set().load(std::memory_order_relaxed);
+}
+
+ppc::core::simd::InstructionSet ppc::core::simd::set_instruction_set(InstructionSet instruction_set) {
+  auto used = std::min(instruction_set, supported_instruction_set());
+  current_instruction_set().store(used, std::memory_order_relaxed);
+  return used;
+}
@@ -0,0 +1,133 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "core/random/include/random.hpp"
+#include "core/task/include/streaming_task.hpp"
+#include "core/task/include/task.hpp"
+
+namespace {
+
+// Sum, minimum and maximum of input, outputs are three int64_t values
+class StreamingStatistics : public ppc::core::StreamingTask<int32_t> {
+ public:
+  using StreamingTask::StreamingTask;
+
+  bool validation() override {
+    internal_order_test();
+    return taskData->outputs_count[0] == 3;
+  }
+
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    auto out = taskData->output_view<int64_t>(0);
+    out[0] = sum;
+    out[1] = minimum;
+    out[2] = maximum;
+    return true;
+  }
+
+  int num_chunks = 0;
+
+ protected:
+  void reset_state() override {
+    sum = 0;
+    minimum = std::numeric_limits<int64_t>::max();
+    maximum = std::numeric_limits<int64_t>::min();
+    num_chunks = 0;
+  }
+
+  bool consume(std::span<const int32_t> chunk) override {
+    for (auto value : chunk) {
+      sum += value;
+      minimum = std::min<int64_t>(minimum, value);
+      maximum = std::max<int64_t>(maximum, value);
+    }
+    num_chunks++;
+    return true;
+  }
+
+ private:
+  int64_t sum = 0;
+  int64_t minimum = 0;
+  int64_t maximum = 0;
+};
+
+std::vector<int64_t> run_statistics(const std::shared_ptr<ppc::core::ChunkSource<int32_t>>& source, int& num_chunks) {
+  std::vector<int64_t> out(3, 0);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  StreamingStatistics task(taskData, source);
+  EXPECT_TRUE(task.validation());
+  task.pre_processing();
+  task.run();
+  task.post_processing();
+  num_chunks = task.num_chunks;
+  return out;
+}
+
+}  // namespace
+
+TEST(streaming_task_tests, check_span_source) {
+  std::vector<int32_t> values(1000);
+  std::iota(values.begin(), values.end(), -500);
+  auto source = std::make_shared<ppc::core::SpanChunkSource<int32_t>>(std::span<const int32_t>(values), 64);
+  EXPECT_EQ(source->size(), 1000u);
+  int num_chunks = 0;
+  EXPECT_EQ(run_statistics(source, num_chunks), (std::vector<int64_t>{-500, -500, 499}));
+  EXPECT_EQ(num_chunks, 16);
+}
+
+TEST(streaming_task_tests, check_generator_source_matches_whole_input) {
+  const uint64_t size = 100003;
+  auto whole = ppc::core::random_vector<int32_t>(size, -1000, 1000, 11);
+  auto source = std::make_shared<ppc::core::GeneratorChunkSource<int32_t>>(
+      size, 4096, [](std::span<int32_t> chunk, uint64_t offset) {
+        ppc::core::fill_uniform(chunk, -1000, 1000, 11, offset);
+      });
+  int num_chunks = 0;
+  auto out = run_statistics(source, num_chunks);
+  EXPECT_EQ(num_chunks, 25);
+  EXPECT_EQ(out[0], std::accumulate(whole.begin(), whole.end(), int64_t{0}));
+  EXPECT_EQ(out[1], *std::min_element(whole.begin(), whole.end()));
+  EXPECT_EQ(out[2], *std::max_element(whole.begin(), whole.end()));
+}
+
+TEST(streaming_task_tests, check_repeated_runs_start_over) {
+  std::vector<int32_t> values(100, 2);
+  auto source = std::make_shared<ppc::core::SpanChunkSource<int32_t>>(std::span<const int32_t>(values), 30);
+  std::vector<int64_t> out(3, 0);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  StreamingStatistics task(taskData, source);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(task.validation());
+    task.pre_processing();
+    task.run();
+    task.post_processing();
+    EXPECT_EQ(out[0], 200);
+  }
+}
+
+TEST(streaming_task_tests, check_empty_input_and_missing_source) {
+  auto source = std::make_shared<ppc::core::SpanChunkSource<int32_t>>(std::span<const int32_t>(), 8);
+  int num_chunks = -1;
+  auto out = run_statistics(source, num_chunks);
+  EXPECT_EQ(num_chunks, 0);
+  EXPECT_EQ(out[0], 0);
+  EXPECT_THROW(StreamingStatistics(std::make_shared<ppc::core::TaskData>(), nullptr), std::invalid_argument);
+}
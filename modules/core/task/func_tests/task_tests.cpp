@@ -1,6 +1,8 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "core/task/func_tests/test_task.hpp"
@@ -154,6 +156,122 @@ TEST(task_tests, check_wrong_order) {
   ASSERT_ANY_THROW(testTask.post_processing());
 }
 
+TEST(task_tests, check_repeated_pipeline_order) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::test::TestTask<int32_t> testTask(taskData);
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_EQ(testTask.validation(), true);
+    testTask.pre_processing();
+    testTask.run();
+    testTask.run();
+    testTask.post_processing();
+  }
+  ASSERT_EQ(static_cast<size_t>(out[0]), 2 * in.size());
+}
+
+TEST(task_tests, check_wrong_order_message) {
+  // Create data
+  std::vector<float> in(20, 1);
+  std::vector<float> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::test::TestTask<float> testTask(taskData);
+  ASSERT_EQ(testTask.validation(), true);
+  try {
+    testTask.run();
+    FAIL();
+  } catch (const std::invalid_argument &e) {
+    std::string message(e.what());
+    EXPECT_NE(message.find("Serial number: 2"), std::string::npos);
+    EXPECT_NE(message.find("Yours function: run"), std::string::npos);
+    EXPECT_NE(message.find("Expected function: pre_processing"), std::string::npos);
+  }
+}
+
+TEST(task_tests, check_input_view) {
+  // Create data
+  std::vector<int32_t> in = {1, 2, 3};
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  auto input = taskData->input_view<int32_t>(0);
+  ASSERT_EQ(input.size(), in.size());
+  EXPECT_EQ(input.data(), in.data());
+  EXPECT_EQ(input[2], 3);
+  EXPECT_EQ(taskData->output_view<int32_t>(0).size(), out.size());
+  EXPECT_THROW(auto unused = taskData->input_view<int32_t>(1), std::out_of_range);
+  EXPECT_THROW(auto unused = taskData->output_view<int32_t>(1), std::out_of_range);
+}
+
+TEST(task_tests, check_copied_inputs) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::test::TestTask<int32_t> testTask(taskData);
+  ASSERT_EQ(testTask.validation(), true);
+  testTask.pre_processing();
+  in[0] = 5;
+  testTask.run();
+  testTask.post_processing();
+  ASSERT_EQ(out[0], 20);
+}
+
+TEST(task_tests, check_borrowed_inputs) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  taskData->borrow_inputs = true;
+
+  // Create Task
+  ppc::test::TestTask<int32_t> testTask(taskData);
+  ASSERT_EQ(testTask.validation(), true);
+  testTask.pre_processing();
+  in[0] = 5;
+  testTask.run();
+  testTask.post_processing();
+  ASSERT_EQ(out[0], 24);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
@@ -18,8 +19,8 @@ class TestTask : public ppc::core::Task {
   explicit TestTask(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
   bool pre_processing() override {
     internal_order_test();
-    input_ = reinterpret_cast<T *>(taskData->inputs[0]);
-    output_ = reinterpret_cast<T *>(taskData->outputs[0]);
+    input_ = acquire_input(0, input_storage_);
+    output_ = taskData->output_view<T>(0).data();
     output_[0] = 0;
     return true;
   }
@@ -31,8 +32,8 @@ class TestTask : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      output_[0] += input_[i];
+    for (const auto &value : input_) {
+      output_[0] += value;
     }
     return true;
   }
@@ -43,7 +44,8 @@ class TestTask : public ppc::core::Task {
   }
 
  private:
-  T *input_{};
+  std::vector<T> input_storage_;
+  std::span<const T> input_;
   T *output_{};
 };
 
@@ -0,0 +1,129 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_STREAMING_TASK_HPP_
+#define MODULES_CORE_INCLUDE_STREAMING_TASK_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Input delivered as a sequence of chunks instead of one resident buffer
+template <class T>
+class ChunkSource {
+ public:
+  virtual ~ChunkSource() = default;
+
+  // Next chunk of input, empty when input is over. Chunk stays valid until the next call.
+  virtual std::span<const T> next() = 0;
+
+  // Start over from the first element
+  virtual void rewind() = 0;
+
+  // Count of elements of whole input
+  [[nodiscard]] virtual uint64_t size() const = 0;
+};
+
+// Chunks of input which is already in memory (or mapped whole), no copies are made
+template <class T>
+class SpanChunkSource : public ChunkSource<T> {
+ public:
+  SpanChunkSource(std::span<const T> data, size_t chunk_size)
+      : data_(data), chunk_size_(std::max<size_t>(chunk_size, 1)) {}
+
+  std::span<const T> next() override {
+    auto count = std::min(chunk_size_, data_.size() - position_);
+    auto chunk = data_.subspan(position_, count);
+    position_ += count;
+    return chunk;
+  }
+
+  void rewind() override { position_ = 0; }
+
+  [[nodiscard]] uint64_t size() const override { return data_.size(); }
+
+ private:
+  std::span<const T> data_;
+  size_t chunk_size_;
+  size_t position_ = 0;
+};
+
+// Input of given size produced chunk by chunk into one reused buffer by generate(chunk, offset),
+// where offset is position of chunk in whole input (see fill_uniform of core/random)
+template <class T>
+class GeneratorChunkSource : public ChunkSource<T> {
+ public:
+  using Generator = std::function<void(std::span<T>, uint64_t)>;
+
+  GeneratorChunkSource(uint64_t size, size_t chunk_size, Generator generate)
+      : size_(size), buffer_(std::max<size_t>(chunk_size, 1)), generate_(std::move(generate)) {}
+
+  std::span<const T> next() override {
+    auto count = static_cast<size_t>(std::min<uint64_t>(buffer_.size(), size_ - position_));
+    std::span<T> chunk(buffer_.data(), count);
+    if (count > 0) {
+      generate_(chunk, position_);
+    }
+    position_ += count;
+    return chunk;
+  }
+
+  void rewind() override { position_ = 0; }
+
+  [[nodiscard]] uint64_t size() const override { return size_; }
+
+ private:
+  uint64_t size_;
+  uint64_t position_ = 0;
+  std::vector<T> buffer_;
+  Generator generate_;
+};
+
+// Task whose run() consumes input from a chunk source and keeps running state between chunks,
+// so only one chunk has to be resident and input may be larger than memory. Every run starts
+// with reset_state() and a rewound source, so repeated runs of perf tests see the whole input.
+// Derived class implements validation, pre_processing and post_processing as usual.
+template <class T>
+class StreamingTask : public Task {
+ public:
+  StreamingTask(std::shared_ptr<TaskData> taskData_, std::shared_ptr<ChunkSource<T>> source_)
+      : Task(std::move(taskData_)), source(std::move(source_)) {
+    if (!source) {
+      throw std::invalid_argument("Streaming task needs a chunk source");
+    }
+  }
+
+  bool run() override {
+    internal_order_test();
+    source->rewind();
+    reset_state();
+    for (auto chunk = source->next(); !chunk.empty(); chunk = source->next()) {
+      if (!consume(chunk)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ protected:
+  // Initialize running state before the first chunk
+  virtual void reset_state() = 0;
+
+  // Update running state with next chunk of input, chunks come in order of input
+  virtual bool consume(std::span<const T> chunk) = 0;
+
+  std::shared_ptr<ChunkSource<T>> source;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_STREAMING_TASK_HPP_
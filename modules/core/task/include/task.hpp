@@ -7,7 +7,10 @@
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace ppc::core {
@@ -18,6 +21,28 @@ struct TaskData {
   std::vector<uint8_t *> outputs;
   std::vector<std::uint32_t> outputs_count;
   enum StateOfTesting { FUNC, PERF } state_of_testing;
+  // inputs stay alive and unchanged while task is used, so task may read them in place instead of copying
+  bool borrow_inputs = false;
+  // name of implementation to create task with from BackendRegistry, empty selects default backend
+  std::string backend;
+
+  // view of i-th input as inputs_count[i] elements of type T
+  template <class T>
+  [[nodiscard]] std::span<const T> input_view(size_t i) const {
+    if (i >= inputs.size() || i >= inputs_count.size()) {
+      throw std::out_of_range("Input index " + std::to_string(i) + " is out of range");
+    }
+    return {reinterpret_cast<const T *>(inputs[i]), inputs_count[i]};
+  }
+
+  // view of i-th output as outputs_count[i] elements of type T
+  template <class T>
+  [[nodiscard]] std::span<T> output_view(size_t i) const {
+    if (i >= outputs.size() || i >= outputs_count.size()) {
+      throw std::out_of_range("Output index " + std::to_string(i) + " is out of range");
+    }
+    return {reinterpret_cast<T *>(outputs[i]), outputs_count[i]};
+  }
 };
 
 // Memory of inputs and outputs need to be initialized before create object of
@@ -44,17 +69,41 @@ class Task {
   // get input and output data
   [[nodiscard]] std::shared_ptr<TaskData> get_data() const;
 
+  // close trace span of the phase which has just returned (core/trace), code driving the task calls it
+  // after every phase; a phase left open ends when the next one starts or the task is destroyed
+  void end_phase();
+
   virtual ~Task();
 
  protected:
-  void internal_order_test(const std::string &str = __builtin_FUNCTION());
+  void internal_order_test(std::string_view str = __builtin_FUNCTION());
+
+  // i-th input borrowed in place if allowed by taskData->borrow_inputs, otherwise copied into storage
+  template <class T>
+  std::span<const T> acquire_input(size_t i, std::vector<T> &storage) const {
+    auto view = taskData->input_view<T>(i);
+    if (taskData->borrow_inputs) {
+      storage.clear();
+      return view;
+    }
+    storage.assign(view.begin(), view.end());
+    return storage;
+  }
+
   std::shared_ptr<TaskData> taskData;
 
  private:
-  std::vector<std::string> functions_order;
-  std::vector<std::string> right_functions_order = {"validation", "pre_processing", "run", "post_processing"};
+  // position of a function in the right order of calls
+  enum class Phase : uint8_t { VALIDATION, PRE_PROCESSING, RUN, POST_PROCESSING, UNKNOWN };
+  Phase last_phase = Phase::UNKNOWN;
+  uint64_t num_ordered_calls = 0;
   const double max_test_time = 1.0;
   std::chrono::high_resolution_clock::time_point tmp_time_point;
+  // phase whose trace span is open, its start and args (core/trace)
+  Phase traced_phase = Phase::UNKNOWN;
+  double phase_begin_us = 0.0;
+  std::string phase_args;
+  void trace_phase(Phase phase);
 };
 
 }  // namespace ppc::core
@@ -3,12 +3,44 @@
 
 #include <gtest/gtest.h>
 
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+#include <array>
+#include <cstdlib>
+#include <memory>
 #include <stdexcept>
+#include <typeinfo>
 #include <utility>
 
+#include "core/trace/include/trace.hpp"
+
+namespace {
+
+constexpr std::array<std::string_view, 4> right_functions_order = {"validation", "pre_processing", "run",
+                                                                   "post_processing"};
+
+// Readable name of dynamic type of task
+std::string task_type_name(const ppc::core::Task& task) {
+  const char* name = typeid(task).name();
+#if defined(__GNUG__)
+  int status = 0;
+  std::unique_ptr<char, void (*)(void*)> demangled(abi::__cxa_demangle(name, nullptr, nullptr, &status), std::free);
+  if (status == 0 && demangled) {
+    return demangled.get();
+  }
+#endif
+  return name;
+}
+
+}  // namespace
+
 void ppc::core::Task::set_data(std::shared_ptr<TaskData> taskData_) {
   taskData_->state_of_testing = TaskData::StateOfTesting::FUNC;
-  functions_order.clear();
+  end_phase();
+  last_phase = Phase::UNKNOWN;
+  num_ordered_calls = 0;
   taskData = std::move(taskData_);
 }
 
@@ -16,24 +48,37 @@ std::shared_ptr<ppc::core::TaskData> ppc::core::Task::get_data() const { return
 
 ppc::core::Task::Task(std::shared_ptr<TaskData> taskData_) { set_data(std::move(taskData_)); }
 
-void ppc::core::Task::internal_order_test(const std::string& str) {
-  if (!functions_order.empty() && str == functions_order.back() && str == "run") return;
+void ppc::core::Task::internal_order_test(std::string_view str) {
+  auto phase = Phase::UNKNOWN;
+  for (size_t i = 0; i < right_functions_order.size(); i++) {
+    if (str == right_functions_order[i]) {
+      phase = static_cast<Phase>(i);
+      break;
+    }
+  }
 
-  functions_order.push_back(str);
+  if (phase == Phase::RUN && last_phase == Phase::RUN) {
+    trace_phase(phase);
+    return;
+  }
 
-  for (size_t i = 0; i < functions_order.size(); i++) {
-    if (functions_order[i] != right_functions_order[i % right_functions_order.size()]) {
-      throw std::invalid_argument("ORDER OF FUCTIONS IS NOT RIGHT: \n" + std::string("Serial number: ") +
-                                  std::to_string(i + 1) + "\n" + std::string("Yours function: ") + functions_order[i] +
-                                  "\n" + std::string("Expected function: ") + right_functions_order[i]);
-    }
+  auto expected = static_cast<Phase>(num_ordered_calls % right_functions_order.size());
+  if (phase != expected) {
+    auto expected_name = right_functions_order[static_cast<size_t>(expected)];
+    throw std::invalid_argument("ORDER OF FUCTIONS IS NOT RIGHT: \n" + std::string("Serial number: ") +
+                                std::to_string(num_ordered_calls + 1) + "\n" + std::string("Yours function: ") +
+                                std::string(str) + "\n" + std::string("Expected function: ") +
+                                std::string(expected_name));
   }
+  last_phase = phase;
+  num_ordered_calls++;
+  trace_phase(phase);
 
-  if (str == "pre_processing" && taskData->state_of_testing == TaskData::StateOfTesting::FUNC) {
+  if (phase == Phase::PRE_PROCESSING && taskData->state_of_testing == TaskData::StateOfTesting::FUNC) {
     tmp_time_point = std::chrono::high_resolution_clock::now();
   }
 
-  if (str == "post_processing" && taskData->state_of_testing == TaskData::StateOfTesting::FUNC) {
+  if (phase == Phase::POST_PROCESSING && taskData->state_of_testing == TaskData::StateOfTesting::FUNC) {
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - tmp_time_point).count();
     auto current_time = static_cast<double>(duration) * 1e-9;
@@ -44,4 +89,27 @@ void ppc::core::Task::internal_order_test(const std::string& str) {
   }
 }
 
-ppc::core::Task::~Task() { functions_order.clear(); }
+// Start of a phase is seen here, its end is reported by end_phase. When the caller doesn't report it,
+// span of a phase is closed by the next phase of task.
+void ppc::core::Task::trace_phase(Phase phase) {
+  if (!Tracer::global().enabled()) {
+    return;
+  }
+  end_phase();
+  if (phase_args.empty()) {
+    phase_args = "\"task\":" + Tracer::json_string(task_type_name(*this));
+  }
+  traced_phase = phase;
+  phase_begin_us = Tracer::now_us();
+}
+
+void ppc::core::Task::end_phase() {
+  if (traced_phase == Phase::UNKNOWN) {
+    return;
+  }
+  Tracer::global().complete(std::string(right_functions_order[static_cast<size_t>(traced_phase)]), "task",
+                            phase_begin_us, phase_args);
+  traced_phase = Phase::UNKNOWN;
+}
+
+ppc::core::Task::~Task() { end_phase(); }
@@ -0,0 +1,288 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/threading/include/reducer.hpp"
+#include "core/threading/include/thread_pool.hpp"
+#include "core/threading/include/threading.hpp"
+#include "core/threading/include/work_stealing.hpp"
+
+TEST(threading_tests, check_default_num_threads) { EXPECT_GE(ppc::core::get_num_threads(), 1); }
+
+TEST(threading_tests, check_set_num_threads) {
+  auto default_num_threads = ppc::core::get_num_threads();
+  ppc::core::set_num_threads(3);
+  EXPECT_EQ(ppc::core::get_num_threads(), 3);
+  ppc::core::set_num_threads(0);
+  EXPECT_EQ(ppc::core::get_num_threads(), default_num_threads);
+}
+
+TEST(thread_pool_tests, check_submit) {
+  ppc::core::ThreadPool pool(2);
+  EXPECT_EQ(pool.num_workers(), 2);
+  auto answer = pool.submit([] { return 42; });
+  auto thread_id = pool.submit([] { return std::this_thread::get_id(); });
+  EXPECT_EQ(answer.get(), 42);
+  EXPECT_NE(thread_id.get(), std::this_thread::get_id());
+}
+
+TEST(thread_pool_tests, check_submit_exception) {
+  ppc::core::ThreadPool pool(1);
+  auto future = pool.submit([]() -> int { throw std::runtime_error("job failed"); });
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(thread_pool_tests, check_parallel_for_covers_range) {
+  ppc::core::ThreadPool pool(3);
+  for (int num_threads : {1, 2, 4, 7}) {
+    std::vector<int> visits(1003, 0);
+    pool.parallel_for(
+        size_t{0}, visits.size(),
+        [&](size_t begin, size_t end) {
+          for (auto i = begin; i < end; i++) {
+            visits[i]++;
+          }
+        },
+        num_threads);
+    EXPECT_EQ(std::count(visits.begin(), visits.end(), 1), static_cast<long>(visits.size()));
+  }
+  EXPECT_EQ(pool.num_workers(), 6);
+}
+
+TEST(thread_pool_tests, check_parallel_for_uses_workers) {
+  ppc::core::ThreadPool pool(3);
+  std::mutex mutex;
+  std::set<std::thread::id> thread_ids;
+  std::atomic<int> arrived{0};
+  pool.parallel_for(
+      0, 4,
+      [&](int, int) {
+        // every chunk waits for others, so they can only finish if they run concurrently
+        arrived++;
+        while (arrived.load() < 4) {
+          std::this_thread::yield();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        thread_ids.insert(std::this_thread::get_id());
+      },
+      4);
+  EXPECT_EQ(thread_ids.size(), 4U);
+}
+
+TEST(thread_pool_tests, check_parallel_for_exception) {
+  ppc::core::ThreadPool pool(2);
+  auto body = [](int begin, int) {
+    if (begin > 0) {
+      throw std::runtime_error("chunk failed");
+    }
+  };
+  EXPECT_THROW(pool.parallel_for(0, 3, body, 3), std::runtime_error);
+}
+
+TEST(thread_pool_tests, check_nested_parallel_for) {
+  ppc::core::ThreadPool pool(2);
+  std::atomic<int> sum{0};
+  pool.parallel_for(
+      0, 3,
+      [&](int, int) {
+        pool.parallel_for(0, 100, [&](int begin, int end) { sum += end - begin; }, 3);
+      },
+      3);
+  EXPECT_EQ(sum.load(), 300);
+}
+
+TEST(thread_pool_tests, check_parallel_reduce) {
+  std::vector<int> values(10001);
+  std::iota(values.begin(), values.end(), 0);
+  auto chunk_sum = [](auto begin, auto end, long init) { return std::accumulate(begin, end, init); };
+  auto& pool = ppc::core::ThreadPool::global();
+  for (int num_threads : {1, 3, 8}) {
+    EXPECT_EQ(pool.parallel_reduce(values.cbegin(), values.cend(), 0L, chunk_sum, std::plus<>(), num_threads),
+              50005000L);
+  }
+  EXPECT_EQ(pool.parallel_reduce(values.cend(), values.cend(), 7L, chunk_sum, std::plus<>()), 7L);
+
+  // order of combination is fixed
+  std::vector<std::string> words = {"a", "b", "c", "d", "e"};
+  auto concat = [&](size_t begin, size_t end, std::string init) {
+    for (auto i = begin; i < end; i++) {
+      init += words[i];
+    }
+    return init;
+  };
+  EXPECT_EQ(pool.parallel_reduce(size_t{0}, words.size(), std::string(), concat, std::plus<>(), 4), "abcde");
+}
+
+TEST(reducer_tests, check_padded_slots) {
+  ppc::core::PaddedReducer<int> reducer(4, 0);
+  EXPECT_EQ(sizeof(ppc::core::CacheLinePadded<int>), ppc::core::cache_line_size);
+  auto first = reinterpret_cast<uintptr_t>(&reducer.local(0));
+  auto second = reinterpret_cast<uintptr_t>(&reducer.local(1));
+  EXPECT_EQ(first % ppc::core::cache_line_size, 0U);
+  EXPECT_EQ(second - first, ppc::core::cache_line_size);
+}
+
+TEST(reducer_tests, check_padded_reducer) {
+  const int num_threads = 4;
+  const int count = 10000;
+  ppc::core::PaddedReducer<long> reducer(num_threads, 0L);
+  std::vector<std::thread> threads;
+  for (int slot = 0; slot < num_threads; slot++) {
+    threads.emplace_back([&, slot] {
+      for (int i = 0; i < count; i++) {
+        reducer.add(slot, 1);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(reducer.result(), static_cast<long>(num_threads) * count);
+  reducer.reset();
+  EXPECT_EQ(reducer.result(), 0L);
+}
+
+TEST(reducer_tests, check_padded_reducer_non_commutative) {
+  auto concat = [](std::string lhs, const std::string& rhs) { return lhs + rhs; };
+  ppc::core::PaddedReducer<std::string, decltype(concat)> reducer(3, "", concat);
+  reducer.add(2, "c");
+  reducer.add(0, "a");
+  reducer.add(1, "b");
+  reducer.add(0, "a");
+  EXPECT_EQ(reducer.result(), "aabc");
+}
+
+TEST(reducer_tests, check_atomic_reducer) {
+  const int num_threads = 4;
+  const int count = 10000;
+  ppc::core::AtomicReducer<int> sum(0);
+  auto max = [](int lhs, int rhs) { return std::max(lhs, rhs); };
+  ppc::core::AtomicReducer<int, decltype(max)> maximum(std::numeric_limits<int>::min(), max);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < count; i++) {
+        sum.add(1);
+        maximum.add(t * count + i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(sum.result(), num_threads * count);
+  EXPECT_EQ(maximum.result(), num_threads * count - 1);
+}
+
+namespace {
+
+long fibonacci(ppc::core::WorkStealingScheduler& scheduler, int n) {
+  if (n < 2) {
+    return n;
+  }
+  long lhs = 0;
+  long rhs = 0;
+  scheduler.invoke([&] { lhs = fibonacci(scheduler, n - 1); }, [&] { rhs = fibonacci(scheduler, n - 2); });
+  return lhs + rhs;
+}
+
+}  // namespace
+
+TEST(work_stealing_tests, check_recursive_invoke) {
+  ppc::core::WorkStealingScheduler scheduler(3);
+  EXPECT_EQ(scheduler.num_workers(), 3);
+  EXPECT_EQ(fibonacci(scheduler, 20), 6765);
+}
+
+TEST(work_stealing_tests, check_task_group) {
+  ppc::core::WorkStealingScheduler scheduler(2);
+  std::atomic<int> sum{0};
+  ppc::core::WorkStealingScheduler::TaskGroup group(scheduler);
+  for (int i = 1; i <= 100; i++) {
+    group.run([&, i] { sum += i; });
+  }
+  group.wait();
+  EXPECT_EQ(sum.load(), 5050);
+}
+
+TEST(work_stealing_tests, check_task_group_exception) {
+  ppc::core::WorkStealingScheduler scheduler(2);
+  ppc::core::WorkStealingScheduler::TaskGroup group(scheduler);
+  std::atomic<int> finished{0};
+  for (int i = 0; i < 10; i++) {
+    group.run([&, i] {
+      if (i == 5) {
+        throw std::runtime_error("job failed");
+      }
+      finished++;
+    });
+  }
+  EXPECT_THROW(group.wait(), std::runtime_error);
+  EXPECT_EQ(finished.load(), 9);
+}
+
+TEST(work_stealing_tests, check_parallel_for_covers_range) {
+  ppc::core::WorkStealingScheduler scheduler(3);
+  for (size_t grain : {0, 1, 7, 5000}) {
+    std::vector<std::atomic<int>> visits(1003);
+    scheduler.parallel_for(
+        size_t{0}, visits.size(),
+        [&](size_t begin, size_t end) {
+          EXPECT_LE(end - begin, grain == 0 ? visits.size() : grain);
+          for (auto i = begin; i < end; i++) {
+            visits[i]++;
+          }
+        },
+        grain);
+    EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](const auto& visit) { return visit.load() == 1; }));
+  }
+}
+
+TEST(work_stealing_tests, check_irregular_work_is_stolen) {
+  ppc::core::WorkStealingScheduler scheduler(3);
+  std::mutex mutex;
+  std::set<std::thread::id> thread_ids;
+  std::atomic<long> sum{0};
+  // cost of element grows with index, static partitioning would leave most threads idle
+  scheduler.parallel_for(
+      0, 256,
+      [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+          long local = 0;
+          for (int j = 0; j < i * 200; j++) {
+            local += j % 7;
+          }
+          sum += local;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        thread_ids.insert(std::this_thread::get_id());
+      },
+      1);
+  EXPECT_GT(sum.load(), 0);
+  EXPECT_GT(thread_ids.size(), 1U);
+}
+
+TEST(work_stealing_tests, check_concurrent_external_callers) {
+  ppc::core::WorkStealingScheduler scheduler(2);
+  std::vector<long> results(4);
+  std::vector<std::thread> callers;
+  for (size_t i = 0; i < results.size(); i++) {
+    callers.emplace_back([&, i] { results[i] = fibonacci(scheduler, 15); });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+  EXPECT_TRUE(std::all_of(results.begin(), results.end(), [](long result) { return result == 610; }));
+}
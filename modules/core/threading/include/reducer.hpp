@@ -0,0 +1,84 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_REDUCER_HPP_
+#define MODULES_CORE_INCLUDE_REDUCER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ppc::core {
+
+// Size of destructive interference on x86 and most ARM cores
+inline constexpr size_t cache_line_size = 64;
+
+template <typename T>
+struct alignas(cache_line_size) CacheLinePadded {
+  T value;
+};
+
+// Partial results of threads, each in its own cache line, so threads updating their
+// slot never invalidate lines of others. Op has to be associative, slots are combined
+// in order, so it doesn't have to be commutative.
+template <typename T, typename Op = std::plus<>>
+class PaddedReducer {
+ public:
+  PaddedReducer(size_t num_slots, T identity, Op op = Op{})
+      : identity(identity), op(std::move(op)), slots(num_slots, CacheLinePadded<T>{identity}) {}
+
+  size_t size() const { return slots.size(); }
+  // Partial result of slot, accessed by one thread only
+  T& local(size_t slot) { return slots[slot].value; }
+  void add(size_t slot, const T& value) {
+    auto& partial = slots[slot].value;
+    partial = op(std::move(partial), value);
+  }
+  // Combine partial results of all slots
+  T result() const {
+    auto result = identity;
+    for (const auto& slot : slots) {
+      result = op(std::move(result), slot.value);
+    }
+    return result;
+  }
+  void reset() {
+    for (auto& slot : slots) {
+      slot.value = identity;
+    }
+  }
+
+ private:
+  T identity;
+  Op op;
+  std::vector<CacheLinePadded<T>> slots;
+};
+
+// Lock-free combine of values from any thread into one result with compare-and-swap.
+// Cheaper than PaddedReducer when every thread adds only a few values; Op has to be
+// associative and commutative since order of additions is not fixed.
+template <typename T, typename Op = std::plus<>>
+class AtomicReducer {
+  static_assert(std::is_trivially_copyable_v<T>, "std::atomic requires trivially copyable type");
+
+ public:
+  explicit AtomicReducer(T identity, Op op = Op{}) : op(std::move(op)), value(identity) {}
+
+  void add(const T& partial) {
+    auto current = value.load(std::memory_order_relaxed);
+    while (!value.compare_exchange_weak(current, op(current, partial), std::memory_order_acq_rel,
+                                        std::memory_order_relaxed)) {
+    }
+  }
+  T result() const { return value.load(std::memory_order_acquire); }
+
+ private:
+  Op op;
+  alignas(cache_line_size) std::atomic<T> value;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_REDUCER_HPP_
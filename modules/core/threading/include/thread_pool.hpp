@@ -0,0 +1,166 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_THREAD_POOL_HPP_
+#define MODULES_CORE_INCLUDE_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/threading/include/reducer.hpp"
+#include "core/threading/include/threading.hpp"
+
+namespace ppc::core {
+
+// Pool of worker threads which live as long as the pool, so tasks pay for thread
+// creation once instead of on every run. Calling thread takes part in parallel_for
+// and parallel_reduce and runs queued jobs while waiting, so nested calls don't deadlock.
+class ThreadPool {
+ public:
+  explicit ThreadPool(int num_workers = 0);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  // Pool shared by all tasks of process, grows on demand up to requested count of threads
+  static ThreadPool& global();
+
+  int num_workers() const;
+  // Start more workers if there are less than num_workers
+  void reserve(int num_workers);
+
+  // Run job on one of workers
+  template <typename F>
+  auto submit(F&& job) -> std::future<std::invoke_result_t<std::decay_t<F>>>;
+
+  // Call body(chunk_begin, chunk_end) for contiguous chunks covering [begin, end) on num_threads threads,
+  // Index is an integer or a random access iterator
+  template <typename Index, typename Body>
+  void parallel_for(Index begin, Index end, Body&& body, int num_threads = get_num_threads());
+
+  // Reduce chunks with chunk_reduce(chunk_begin, chunk_end, identity) and combine partial results
+  // with combine(lhs, rhs) in order of chunks, so result doesn't depend on scheduling
+  template <typename T, typename Index, typename ChunkReduce, typename Combine>
+  T parallel_reduce(Index begin, Index end, T identity, ChunkReduce&& chunk_reduce, Combine&& combine,
+                    int num_threads = get_num_threads());
+
+ private:
+  // Jobs of one parallel_for call, caller waits until all of them are done
+  struct Batch {
+    std::atomic<size_t> remaining{0};
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr exception;
+  };
+
+  // Start of chunk when size elements are split into num_chunks, first size % num_chunks chunks are one longer
+  static size_t chunk_offset(size_t chunk, size_t size, size_t num_chunks) {
+    return chunk * (size / num_chunks) + std::min(chunk, size % num_chunks);
+  }
+  void enqueue(std::function<void()> job);
+  bool run_pending_job();
+  void worker_loop();
+  void wait(Batch& batch);
+  static void finish(Batch& batch, std::exception_ptr exception);
+
+  std::vector<std::thread> workers;
+  std::deque<std::function<void()>> jobs;
+  mutable std::mutex mutex;
+  std::condition_variable has_jobs;
+  bool stopping = false;
+};
+
+template <typename F>
+auto ThreadPool::submit(F&& job) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+  using Result = std::invoke_result_t<std::decay_t<F>>;
+  reserve(1);
+  auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(job));
+  auto future = task->get_future();
+  enqueue([task] { (*task)(); });
+  return future;
+}
+
+template <typename Index, typename Body>
+void ThreadPool::parallel_for(Index begin, Index end, Body&& body, int num_threads) {
+  if (end <= begin) {
+    return;
+  }
+  auto size = static_cast<size_t>(end - begin);
+  auto num_chunks = std::min(static_cast<size_t>(std::max(num_threads, 1)), size);
+  if (num_chunks == 1) {
+    body(begin, end);
+    return;
+  }
+  reserve(static_cast<int>(num_chunks) - 1);
+
+  using Difference = decltype(end - begin);
+  auto chunk_begin = [&](size_t chunk) {
+    return begin + static_cast<Difference>(chunk_offset(chunk, size, num_chunks));
+  };
+
+  Batch batch;
+  batch.remaining.store(num_chunks - 1);
+  for (size_t chunk = 1; chunk < num_chunks; chunk++) {
+    enqueue([&, chunk] {
+      std::exception_ptr exception;
+      try {
+        body(chunk_begin(chunk), chunk_begin(chunk + 1));
+      } catch (...) {
+        exception = std::current_exception();
+      }
+      finish(batch, exception);
+    });
+  }
+
+  std::exception_ptr exception;
+  try {
+    body(chunk_begin(0), chunk_begin(1));
+  } catch (...) {
+    exception = std::current_exception();
+  }
+  wait(batch);
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+  if (batch.exception) {
+    std::rethrow_exception(batch.exception);
+  }
+}
+
+template <typename T, typename Index, typename ChunkReduce, typename Combine>
+T ThreadPool::parallel_reduce(Index begin, Index end, T identity, ChunkReduce&& chunk_reduce, Combine&& combine,
+                              int num_threads) {
+  if (end <= begin) {
+    return identity;
+  }
+  auto size = static_cast<size_t>(end - begin);
+  auto num_chunks = std::min(static_cast<size_t>(std::max(num_threads, 1)), size);
+
+  // chunks write partial results to their own cache lines and never contend
+  PaddedReducer<T, std::decay_t<Combine>> partial(num_chunks, identity, std::forward<Combine>(combine));
+  using Difference = decltype(end - begin);
+  auto reduce_chunks = [&](size_t first_chunk, size_t last_chunk) {
+    for (auto chunk = first_chunk; chunk < last_chunk; chunk++) {
+      auto chunk_begin = begin + static_cast<Difference>(chunk_offset(chunk, size, num_chunks));
+      auto chunk_end = begin + static_cast<Difference>(chunk_offset(chunk + 1, size, num_chunks));
+      partial.local(chunk) = chunk_reduce(chunk_begin, chunk_end, identity);
+    }
+  };
+  parallel_for(size_t{0}, num_chunks, reduce_chunks, static_cast<int>(num_chunks));
+  return partial.result();
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_THREAD_POOL_HPP_
@@ -0,0 +1,17 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_THREADING_HPP_
+#define MODULES_CORE_INCLUDE_THREADING_HPP_
+
+namespace ppc::core {
+
+// Count of threads used by std::thread based tasks. Defaults to PPC_NUM_THREADS
+// environment variable if it is set, otherwise to std::thread::hardware_concurrency()
+int get_num_threads();
+
+// Override count of threads, non-positive value restores default
+void set_num_threads(int num_threads);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_THREADING_HPP_
@@ -0,0 +1,148 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_WORK_STEALING_HPP_
+#define MODULES_CORE_INCLUDE_WORK_STEALING_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/threading/include/reducer.hpp"
+#include "core/threading/include/threading.hpp"
+
+namespace ppc::core {
+
+// Scheduler for recursive and irregular parallelism. Every worker owns a deque: it pushes
+// and pops jobs at the back (newest first, hot in cache), idle workers steal from the front
+// of randomly chosen victims (oldest first, usually the biggest pieces of work). Threads
+// waiting for a group execute jobs instead of blocking, so fork/join can nest arbitrarily.
+class WorkStealingScheduler {
+ public:
+  class TaskGroup;
+
+  explicit WorkStealingScheduler(int num_workers = get_num_threads());
+  WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+  WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+  ~WorkStealingScheduler();
+
+  // Scheduler shared by all tasks of process
+  static WorkStealingScheduler& global();
+
+  int num_workers() const { return static_cast<int>(workers.size()); }
+
+  // Run f1 and f2 in parallel and wait for both
+  template <typename F1, typename F2>
+  void invoke(F1&& f1, F2&& f2);
+
+  // Call body(chunk_begin, chunk_end) on chunks of [begin, end) not longer than grain, range is split
+  // recursively in halves, so idle workers steal big halves. Zero grain means about 8 chunks per worker.
+  template <typename Index, typename Body>
+  void parallel_for(Index begin, Index end, Body&& body, size_t grain = 0);
+
+ private:
+  using Job = std::function<void()>;
+  struct alignas(cache_line_size) Worker {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  void spawn(Job job);
+  bool run_one();
+  bool pop_or_steal(Job& job, int self);
+  void worker_loop(int index);
+  int current_worker() const;
+
+  template <typename Index, typename Body>
+  static void split_range(TaskGroup& group, Index begin, Index end, size_t grain, const Body& body);
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::vector<std::thread> threads;
+  std::atomic<size_t> num_queued{0};
+  std::atomic<int> num_sleeping{0};
+  std::atomic<size_t> next_victim{0};
+  std::mutex sleep_mutex;
+  std::condition_variable has_jobs;
+  std::atomic<bool> stopping{false};
+};
+
+// Set of jobs forked with run() and joined with wait(), the first exception of jobs is rethrown by wait()
+class WorkStealingScheduler::TaskGroup {
+ public:
+  explicit TaskGroup(WorkStealingScheduler& scheduler = WorkStealingScheduler::global()) : scheduler(scheduler) {}
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+  ~TaskGroup() { join(); }
+
+  template <typename F>
+  void run(F&& job);
+  void wait();
+
+ private:
+  void join();
+
+  WorkStealingScheduler& scheduler;
+  std::atomic<size_t> pending{0};
+  std::mutex mutex;
+  std::exception_ptr exception;
+};
+
+template <typename F>
+void WorkStealingScheduler::TaskGroup::run(F&& job) {
+  pending.fetch_add(1, std::memory_order_relaxed);
+  scheduler.spawn([this, job = std::forward<F>(job)]() mutable {
+    try {
+      job();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!exception) {
+        exception = std::current_exception();
+      }
+    }
+    pending.fetch_sub(1, std::memory_order_acq_rel);
+  });
+}
+
+template <typename F1, typename F2>
+void WorkStealingScheduler::invoke(F1&& f1, F2&& f2) {
+  // if f1 throws, destructor of group still waits for f2
+  TaskGroup group(*this);
+  group.run(std::forward<F2>(f2));
+  f1();
+  group.wait();
+}
+
+template <typename Index, typename Body>
+void WorkStealingScheduler::parallel_for(Index begin, Index end, Body&& body, size_t grain) {
+  if (end <= begin) {
+    return;
+  }
+  if (grain == 0) {
+    grain = std::max<size_t>(1, static_cast<size_t>(end - begin) / (8 * static_cast<size_t>(num_workers())));
+  }
+  TaskGroup group(*this);
+  split_range(group, begin, end, grain, body);
+  group.wait();
+}
+
+template <typename Index, typename Body>
+void WorkStealingScheduler::split_range(TaskGroup& group, Index begin, Index end, size_t grain, const Body& body) {
+  while (static_cast<size_t>(end - begin) > grain) {
+    auto middle = begin + (end - begin) / 2;
+    group.run([&group, middle, end, grain, &body] { split_range(group, middle, end, grain, body); });
+    end = middle;
+  }
+  body(begin, end);
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_WORK_STEALING_HPP_
@@ -0,0 +1,92 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/threading/include/thread_pool.hpp"
+
+ppc::core::ThreadPool::ThreadPool(int num_workers) { reserve(num_workers); }
+
+ppc::core::ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  has_jobs.notify_all();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+ppc::core::ThreadPool& ppc::core::ThreadPool::global() {
+  static ThreadPool pool(get_num_threads() - 1);
+  return pool;
+}
+
+int ppc::core::ThreadPool::num_workers() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return static_cast<int>(workers.size());
+}
+
+void ppc::core::ThreadPool::reserve(int num_workers) {
+  std::lock_guard<std::mutex> lock(mutex);
+  while (static_cast<int>(workers.size()) < num_workers) {
+    workers.emplace_back([this] { worker_loop(); });
+  }
+}
+
+void ppc::core::ThreadPool::enqueue(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    jobs.push_back(std::move(job));
+  }
+  has_jobs.notify_one();
+}
+
+bool ppc::core::ThreadPool::run_pending_job() {
+  std::function<void()> job;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (jobs.empty()) {
+      return false;
+    }
+    job = std::move(jobs.front());
+    jobs.pop_front();
+  }
+  job();
+  return true;
+}
+
+void ppc::core::ThreadPool::worker_loop() {
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      has_jobs.wait(lock, [this] { return stopping || !jobs.empty(); });
+      if (jobs.empty()) {
+        return;
+      }
+      job = std::move(jobs.front());
+      jobs.pop_front();
+    }
+    job();
+  }
+}
+
+void ppc::core::ThreadPool::wait(Batch& batch) {
+  // Jobs of batch are queued before waiting, so once the queue is empty they are all taken by workers
+  while (batch.remaining.load(std::memory_order_acquire) > 0) {
+    if (!run_pending_job()) {
+      std::unique_lock<std::mutex> lock(batch.mutex);
+      batch.done.wait(lock, [&] { return batch.remaining.load(std::memory_order_acquire) == 0; });
+    }
+  }
+  // last job may still hold the mutex of batch which lives on caller's stack
+  std::lock_guard<std::mutex> lock(batch.mutex);
+}
+
+void ppc::core::ThreadPool::finish(Batch& batch, std::exception_ptr exception) {
+  std::lock_guard<std::mutex> lock(batch.mutex);
+  if (exception && !batch.exception) {
+    batch.exception = exception;
+  }
+  if (batch.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    batch.done.notify_all();
+  }
+}
@@ -0,0 +1,38 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/threading/include/threading.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+std::atomic<int> num_threads_override{0};
+
+int default_num_threads() {
+  if (const char* env = std::getenv("PPC_NUM_THREADS")) {
+    try {
+      auto value = std::stoi(env);
+      if (value > 0) {
+        return value;
+      }
+    } catch (const std::exception&) {
+      // ignore malformed value and fall back to hardware concurrency
+    }
+  }
+  return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+}  // namespace
+
+int ppc::core::get_num_threads() {
+  auto value = num_threads_override.load(std::memory_order_relaxed);
+  return value > 0 ? value : default_num_threads();
+}
+
+void ppc::core::set_num_threads(int num_threads) {
+  num_threads_override.store(std::max(num_threads, 0), std::memory_order_relaxed);
+}
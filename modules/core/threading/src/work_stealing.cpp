@@ -0,0 +1,141 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/threading/include/work_stealing.hpp"
+
+#include <functional>
+#include <random>
+
+namespace {
+
+// Scheduler and deque index of calling thread, if it is a worker
+struct CurrentWorker {
+  const ppc::core::WorkStealingScheduler* scheduler = nullptr;
+  int index = -1;
+};
+
+thread_local CurrentWorker current;
+
+size_t random_index(size_t bound) {
+  thread_local std::minstd_rand generator(
+      static_cast<unsigned>(std::hash<std::thread::id>{}(std::this_thread::get_id())));
+  return generator() % bound;
+}
+
+}  // namespace
+
+ppc::core::WorkStealingScheduler::WorkStealingScheduler(int num_workers) {
+  num_workers = std::max(num_workers, 1);
+  for (int i = 0; i < num_workers; i++) {
+    workers.push_back(std::make_unique<Worker>());
+  }
+  for (int i = 0; i < num_workers; i++) {
+    threads.emplace_back([this, i] { worker_loop(i); });
+  }
+}
+
+ppc::core::WorkStealingScheduler::~WorkStealingScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    stopping.store(true);
+  }
+  has_jobs.notify_all();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+ppc::core::WorkStealingScheduler& ppc::core::WorkStealingScheduler::global() {
+  // calling thread executes jobs while it waits, so it counts as one of threads
+  static WorkStealingScheduler scheduler(get_num_threads() - 1);
+  return scheduler;
+}
+
+int ppc::core::WorkStealingScheduler::current_worker() const {
+  return current.scheduler == this ? current.index : -1;
+}
+
+void ppc::core::WorkStealingScheduler::spawn(Job job) {
+  // workers push to their own deque, other threads spread jobs over workers
+  auto self = current_worker();
+  auto target = self >= 0 ? static_cast<size_t>(self) : next_victim.fetch_add(1) % workers.size();
+  {
+    std::lock_guard<std::mutex> lock(workers[target]->mutex);
+    workers[target]->jobs.push_back(std::move(job));
+  }
+  num_queued.fetch_add(1);
+  if (num_sleeping.load() > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    has_jobs.notify_one();
+  }
+}
+
+bool ppc::core::WorkStealingScheduler::pop_or_steal(Job& job, int self) {
+  if (self >= 0) {
+    auto& worker = *workers[self];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.jobs.empty()) {
+      job = std::move(worker.jobs.back());
+      worker.jobs.pop_back();
+      num_queued.fetch_sub(1);
+      return true;
+    }
+  }
+
+  auto first_victim = random_index(workers.size());
+  for (size_t i = 0; i < workers.size(); i++) {
+    auto victim = (first_victim + i) % workers.size();
+    if (static_cast<int>(victim) == self) {
+      continue;
+    }
+    auto& worker = *workers[victim];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.jobs.empty()) {
+      job = std::move(worker.jobs.front());
+      worker.jobs.pop_front();
+      num_queued.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ppc::core::WorkStealingScheduler::run_one() {
+  Job job;
+  if (!pop_or_steal(job, current_worker())) {
+    return false;
+  }
+  job();
+  return true;
+}
+
+void ppc::core::WorkStealingScheduler::worker_loop(int index) {
+  current = {this, index};
+  while (!stopping.load()) {
+    if (run_one()) {
+      continue;
+    }
+    // registered as sleeping before checking for jobs, so spawn either sees us or we see its job
+    num_sleeping.fetch_add(1);
+    {
+      std::unique_lock<std::mutex> lock(sleep_mutex);
+      has_jobs.wait(lock, [this] { return stopping.load() || num_queued.load() > 0; });
+    }
+    num_sleeping.fetch_sub(1);
+  }
+}
+
+void ppc::core::WorkStealingScheduler::TaskGroup::join() {
+  while (pending.load(std::memory_order_acquire) > 0) {
+    if (!scheduler.run_one()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void ppc::core::WorkStealingScheduler::TaskGroup::wait() {
+  join();
+  if (exception) {
+    auto rethrown = exception;
+    exception = nullptr;
+    std::rethrow_exception(rethrown);
+  }
+}
@@ -0,0 +1,166 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/task/func_tests/test_task.hpp"
+#include "core/trace/include/trace.hpp"
+
+namespace {
+
+size_t count_of(const std::string& text, const std::string& pattern) {
+  size_t count = 0;
+  for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+    count++;
+  }
+  return count;
+}
+
+// Enable global tracer for the test and restore it after
+class ScopedTracing {
+ public:
+  ScopedTracing() : was_enabled(ppc::core::Tracer::global().enabled()) {
+    ppc::core::Tracer::global().clear();
+    ppc::core::Tracer::global().set_enabled(true);
+  }
+  ScopedTracing(const ScopedTracing&) = delete;
+  ScopedTracing& operator=(const ScopedTracing&) = delete;
+  ~ScopedTracing() {
+    ppc::core::Tracer::global().set_enabled(was_enabled);
+    ppc::core::Tracer::global().clear();
+  }
+
+ private:
+  bool was_enabled;
+};
+
+}  // namespace
+
+TEST(trace_tests, check_span_is_recorded_only_when_enabled) {
+  auto& tracer = ppc::core::Tracer::global();
+  if (!tracer.enabled()) {
+    ppc::core::TraceSpan span("invisible");
+  }
+  EXPECT_EQ(count_of(tracer.events_json(), "invisible"), 0U);
+
+  ScopedTracing tracing;
+  { ppc::core::TraceSpan span("visible", "test"); }
+  tracer.instant("marker", "test", "\"value\":1");
+  auto events = tracer.events_json();
+  EXPECT_EQ(count_of(events, "{\"name\":\"visible\",\"cat\":\"test\",\"ph\":\"X\""), 1U);
+  EXPECT_EQ(count_of(events, "\"ph\":\"i\""), 1U);
+  EXPECT_EQ(count_of(events, "\"args\":{\"value\":1}"), 1U);
+  EXPECT_EQ(count_of(events, "\"process_name\""), 1U);
+}
+
+TEST(trace_tests, check_threads_have_own_ids) {
+  ScopedTracing tracing;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 3; i++) {
+    threads.emplace_back([i] {
+      if (i == 0) {
+        ppc::core::Tracer::global().set_thread_name("named worker");
+      }
+      ppc::core::TraceSpan span("work");
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto events = ppc::core::Tracer::global().events_json();
+  EXPECT_EQ(count_of(events, "\"name\":\"work\""), 3U);
+  EXPECT_EQ(count_of(events, "named worker"), 1U);
+  // spans of different threads are on different tracks
+  std::vector<std::string> tids;
+  std::istringstream lines(events);
+  for (std::string line; std::getline(lines, line);) {
+    if (line.find("\"name\":\"work\"") != std::string::npos) {
+      auto begin = line.find("\"tid\":");
+      tids.push_back(line.substr(begin, line.find(',', begin) - begin));
+    }
+  }
+  ASSERT_EQ(tids.size(), 3U);
+  EXPECT_NE(tids[0], tids[1]);
+  EXPECT_NE(tids[1], tids[2]);
+  EXPECT_NE(tids[0], tids[2]);
+}
+
+TEST(trace_tests, check_task_phases_are_traced) {
+  ScopedTracing tracing;
+  std::vector<int32_t> in(100, 1);
+  std::vector<int32_t> out(1, 0);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  {
+    ppc::test::TestTask<int32_t> testTask(taskData);
+    ASSERT_TRUE(testTask.validation());
+    testTask.end_phase();
+    testTask.pre_processing();
+    testTask.run();
+    testTask.run();
+    testTask.end_phase();
+    testTask.post_processing();
+    // last phase which wasn't ended explicitly is closed by destruction of task
+  }
+
+  auto events = ppc::core::Tracer::global().events_json();
+  EXPECT_EQ(count_of(events, "{\"name\":\"validation\",\"cat\":\"task\",\"ph\":\"X\""), 1U);
+  EXPECT_EQ(count_of(events, "{\"name\":\"pre_processing\",\"cat\":\"task\",\"ph\":\"X\""), 1U);
+  EXPECT_EQ(count_of(events, "{\"name\":\"run\",\"cat\":\"task\",\"ph\":\"X\""), 2U);
+  EXPECT_EQ(count_of(events, "{\"name\":\"post_processing\",\"cat\":\"task\",\"ph\":\"X\""), 1U);
+  EXPECT_EQ(count_of(events, "\"ph\":\"i\""), 0U);
+  EXPECT_EQ(count_of(events, "TestTask"), 5U);
+  // output accumulates over both runs
+  EXPECT_EQ(out[0], 200);
+}
+
+TEST(trace_tests, check_phase_ends_when_it_returns) {
+  ScopedTracing tracing;
+  std::vector<int32_t> in(100, 1);
+  std::vector<int32_t> out(1, 0);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  ppc::test::TestTask<int32_t> testTask(taskData);
+  ASSERT_TRUE(testTask.validation());
+  testTask.end_phase();
+  // gap between phases isn't counted into validation
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  testTask.pre_processing();
+  testTask.end_phase();
+
+  auto events = ppc::core::Tracer::global().events_json();
+  auto validation = events.find("{\"name\":\"validation\"");
+  ASSERT_NE(validation, std::string::npos);
+  auto duration = events.find("\"dur\":", validation);
+  ASSERT_NE(duration, std::string::npos);
+  EXPECT_LT(std::stod(events.substr(duration + 6)), 20000.0);
+}
+
+TEST(trace_tests, check_write) {
+  ScopedTracing tracing;
+  { ppc::core::TraceSpan span("written \"quoted\"\n"); }
+  auto path = (std::filesystem::temp_directory_path() / "ppc_trace_tests.json").string();
+  ppc::core::Tracer::global().write(path);
+
+  std::ifstream file(path);
+  std::stringstream content;
+  content << file.rdbuf();
+  auto text = content.str();
+  EXPECT_EQ(text.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0U);
+  EXPECT_EQ(count_of(text, "\"name\":\"written \\\"quoted\\\"\\u000a\""), 1U);
+  EXPECT_EQ(text.substr(text.size() - 3), "]}\n");
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,113 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_TRACE_HPP_
+#define MODULES_CORE_INCLUDE_TRACE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ppc::core {
+
+// Timeline of what every thread of every process was doing, written as Chrome trace-event JSON
+// (open it in https://ui.perfetto.dev or chrome://tracing). Phases of every Task are recorded from
+// internal_order_test till Task::end_phase, chunks of shared memory patterns and user code are
+// recorded with TraceSpan.
+//
+// Tracing is off unless PPC_TRACE names a file: then events are recorded and written there at
+// exit, every MPI process writes its own file with ".rank<N>" before extension (or all ranks are
+// gathered into one file by write_trace of core/mpi/include/trace_mpi.hpp). Disabled tracing costs
+// one atomic load per event.
+class Tracer {
+ public:
+  struct Event {
+    std::string name;
+    std::string category;
+    // microseconds of steady clock, which is shared by processes of one machine
+    double begin_us = 0.0;
+    // duration of complete event, instant events have none
+    double duration_us = 0.0;
+    bool instant = false;
+    std::string args;
+  };
+
+  static Tracer& global();
+
+  [[nodiscard]] bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+  void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+  // Process of trace events (MPI rank), taken from launcher's environment by default
+  void set_process(int process_id);
+  [[nodiscard]] int process() const { return process_id_; }
+
+  // Name shown for calling thread instead of "thread <id>"
+  void set_thread_name(std::string name);
+
+  static double now_us();
+  // value quoted and escaped as JSON string
+  static std::string json_string(std::string_view value);
+
+  // Span of calling thread from begin_us till now, args is JSON object body ("\"key\":value,...")
+  void complete(std::string name, std::string category, double begin_us, std::string args = {});
+  void instant(std::string name, std::string category, std::string args = {});
+
+  // Recorded events of this process as comma-separated JSON objects, thread names included
+  [[nodiscard]] std::string events_json() const;
+  void clear();
+
+  // Write events of this process into file of Chrome trace format
+  void write(const std::string& path) const;
+  // Write events joined by write_trace of several processes
+  static void write_events(const std::string& path, const std::string& events_json);
+
+  // File given by PPC_TRACE, empty if tracing wasn't requested
+  [[nodiscard]] const std::string& path() const { return path_; }
+  // Skip writing at exit, trace was written another way
+  void mark_written() { written_ = true; }
+
+ private:
+  struct ThreadBuffer {
+    int thread_id = 0;
+    std::string name;
+    std::mutex mutex;
+    std::vector<Event> events;
+  };
+
+  Tracer();
+  ThreadBuffer& buffer();
+  void record(Event event);
+  void write_at_exit();
+
+  std::atomic<bool> enabled_{false};
+  int process_id_ = 0;
+  // launched by MPI, so every process needs a file of its own
+  bool multi_process_ = false;
+  std::string path_;
+  bool written_ = false;
+  mutable std::mutex buffers_mutex_;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+// Complete event of calling thread from construction till destruction, name and category
+// have to outlive the span (string literals usually)
+class TraceSpan {
+ public:
+  TraceSpan(std::string_view name, std::string_view category = "user");
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+  ~TraceSpan();
+
+ private:
+  std::string_view name;
+  std::string_view category;
+  double begin_us = 0.0;
+  bool active = false;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_TRACE_HPP_
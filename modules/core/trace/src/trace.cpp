@@ -0,0 +1,208 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/trace/include/trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Rank given to the process by MPI launcher, -1 outside of MPI
+int launcher_rank() {
+  for (const char* name : {"OMPI_COMM_WORLD_RANK", "PMI_RANK", "PMIX_RANK", "MPI_LOCALRANKID"}) {
+    if (const char* env = std::getenv(name)) {
+      return std::atoi(env);
+    }
+  }
+  return -1;
+}
+
+void write_event(std::ostream& out, int process_id, int thread_id, const ppc::core::Tracer::Event& event) {
+  out << "{\"name\":" << ppc::core::Tracer::json_string(event.name)
+      << ",\"cat\":" << ppc::core::Tracer::json_string(event.category) << ",\"ph\":\"" << (event.instant ? "i" : "X")
+      << "\",\"pid\":" << process_id << ",\"tid\":" << thread_id << ",\"ts\":" << event.begin_us;
+  if (event.instant) {
+    out << ",\"s\":\"t\"";
+  } else {
+    out << ",\"dur\":" << event.duration_us;
+  }
+  if (!event.args.empty()) {
+    out << ",\"args\":{" << event.args << "}";
+  }
+  out << "}";
+}
+
+void write_metadata(std::ostream& out, int process_id, int thread_id, const char* kind, const std::string& name) {
+  out << "{\"name\":\"" << kind << "\",\"ph\":\"M\",\"pid\":" << process_id << ",\"tid\":" << thread_id
+      << ",\"args\":{\"name\":" << ppc::core::Tracer::json_string(name) << "}}";
+}
+
+}  // namespace
+
+ppc::core::Tracer::Tracer() {
+  auto rank = launcher_rank();
+  multi_process_ = rank >= 0;
+  process_id_ = std::max(rank, 0);
+  if (const char* env = std::getenv("PPC_TRACE")) {
+    path_ = env;
+    enabled_ = !path_.empty();
+  }
+  if (enabled()) {
+    std::atexit([] { global().write_at_exit(); });
+  }
+}
+
+ppc::core::Tracer& ppc::core::Tracer::global() {
+  // never destroyed, threads of static pools may record events while statics are torn down
+  static auto* tracer = new Tracer();
+  return *tracer;
+}
+
+void ppc::core::Tracer::set_process(int process_id) {
+  process_id_ = process_id;
+  multi_process_ = true;
+}
+
+void ppc::core::Tracer::set_thread_name(std::string name) {
+  auto& thread_buffer = buffer();
+  std::lock_guard lock(thread_buffer.mutex);
+  thread_buffer.name = std::move(name);
+}
+
+double ppc::core::Tracer::now_us() {
+  auto since_epoch = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration<double, std::micro>(since_epoch).count();
+}
+
+std::string ppc::core::Tracer::json_string(std::string_view value) {
+  std::string quoted = "\"";
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      quoted += '\\';
+      quoted += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      quoted += escaped;
+    } else {
+      quoted += c;
+    }
+  }
+  return quoted + "\"";
+}
+
+ppc::core::Tracer::ThreadBuffer& ppc::core::Tracer::buffer() {
+  // buffer is shared with tracer, so events of finished threads stay until they are written
+  thread_local std::shared_ptr<ThreadBuffer> thread_buffer;
+  if (!thread_buffer) {
+    thread_buffer = std::make_shared<ThreadBuffer>();
+    std::lock_guard lock(buffers_mutex_);
+    thread_buffer->thread_id = static_cast<int>(buffers_.size());
+    buffers_.push_back(thread_buffer);
+  }
+  return *thread_buffer;
+}
+
+void ppc::core::Tracer::record(Event event) {
+  auto& thread_buffer = buffer();
+  // only writers of trace contend with owning thread for the lock
+  std::lock_guard lock(thread_buffer.mutex);
+  thread_buffer.events.push_back(std::move(event));
+}
+
+void ppc::core::Tracer::complete(std::string name, std::string category, double begin_us, std::string args) {
+  if (!enabled()) {
+    return;
+  }
+  auto end_us = now_us();
+  record({std::move(name), std::move(category), begin_us, end_us - begin_us, false, std::move(args)});
+}
+
+void ppc::core::Tracer::instant(std::string name, std::string category, std::string args) {
+  if (!enabled()) {
+    return;
+  }
+  record({std::move(name), std::move(category), now_us(), 0.0, true, std::move(args)});
+}
+
+std::string ppc::core::Tracer::events_json() const {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(3);
+  bool first = true;
+  auto separate = [&] {
+    out << (first ? "" : ",\n");
+    first = false;
+  };
+  separate();
+  write_metadata(out, process_id_, 0, "process_name", "rank " + std::to_string(process_id_));
+
+  std::lock_guard buffers_lock(buffers_mutex_);
+  for (const auto& thread_buffer : buffers_) {
+    std::lock_guard lock(thread_buffer->mutex);
+    auto thread_id = thread_buffer->thread_id;
+    auto name = thread_buffer->name.empty() ? "thread " + std::to_string(thread_id) : thread_buffer->name;
+    separate();
+    write_metadata(out, process_id_, thread_id, "thread_name", name);
+    for (const auto& event : thread_buffer->events) {
+      separate();
+      write_event(out, process_id_, thread_id, event);
+    }
+  }
+  return out.str();
+}
+
+void ppc::core::Tracer::clear() {
+  std::lock_guard buffers_lock(buffers_mutex_);
+  for (const auto& thread_buffer : buffers_) {
+    std::lock_guard lock(thread_buffer->mutex);
+    thread_buffer->events.clear();
+  }
+}
+
+void ppc::core::Tracer::write(const std::string& path) const { write_events(path, events_json()); }
+
+void ppc::core::Tracer::write_events(const std::string& path, const std::string& events_json) {
+  std::ofstream out(path);
+  if (!out) {
+    throw std::runtime_error("Can't write trace to " + path);
+  }
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" << events_json << "\n]}\n";
+}
+
+void ppc::core::Tracer::write_at_exit() {
+  if (written_ || path_.empty()) {
+    return;
+  }
+  auto path = path_;
+  if (multi_process_) {
+    std::filesystem::path file(path_);
+    auto name = file.stem().string() + ".rank" + std::to_string(process_id_) + file.extension().string();
+    path = (file.parent_path() / name).string();
+  }
+  try {
+    write(path);
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << std::endl;
+  }
+}
+
+ppc::core::TraceSpan::TraceSpan(std::string_view name_, std::string_view category_)
+    : name(name_), category(category_), active(Tracer::global().enabled()) {
+  if (active) {
+    begin_us = Tracer::now_us();
+  }
+}
+
+ppc::core::TraceSpan::~TraceSpan() {
+  if (active) {
+    Tracer::global().complete(std::string(name), std::string(category), begin_us);
+  }
+}
@@ -6,9 +6,10 @@
 #include <gtest/gtest.h>
 
 #include <memory>
-#include <numeric>
+#include <span>
 #include <vector>
 
+#include "core/simd/include/simd.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -21,11 +22,7 @@ class AverageOfVectorElements : public ppc::core::Task {
   bool pre_processing() override {
     internal_order_test();
     // Init vectors
-    input_ = std::vector<InType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = acquire_input(0, input_storage_);
     // Init value for output
     average = 0.0;
     return true;
@@ -39,7 +36,7 @@ class AverageOfVectorElements : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    average = static_cast<OutType>(std::accumulate(input_.begin(), input_.end(), 0.0));
+    average = static_cast<OutType>(ppc::core::simd::sum<double>(input_));
     average /= static_cast<OutType>(taskData->inputs_count[0]);
     return true;
   }
@@ -51,7 +48,8 @@ class AverageOfVectorElements : public ppc::core::Task {
   }
 
  private:
-  std::vector<InType> input_;
+  std::vector<InType> input_storage_;
+  std::span<const InType> input_;
   OutType average;
 };
 
@@ -5,11 +5,11 @@
 
 #include <gtest/gtest.h>
 
-#include <algorithm>
 #include <memory>
-#include <numeric>
+#include <span>
 #include <vector>
 
+#include "core/simd/include/simd.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -22,11 +22,7 @@ class MaxOfVectorElements : public ppc::core::Task {
   bool pre_processing() override {
     internal_order_test();
     // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = acquire_input(0, input_storage_);
     // Init value for output
     max = 0.0;
     max_index = 0;
@@ -46,9 +42,10 @@ class MaxOfVectorElements : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    auto result = std::max_element(input_.begin(), input_.end());
-    max = static_cast<InOutType>(*result);
-    max_index = static_cast<IndexType>(std::distance(input_.begin(), result));
+    // first largest element as std::max_element finds it
+    auto index = ppc::core::simd::max_index(input_);
+    max = static_cast<InOutType>(input_[index]);
+    max_index = static_cast<IndexType>(index);
     return true;
   }
 
@@ -60,7 +57,8 @@ class MaxOfVectorElements : public ppc::core::Task {
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::vector<InOutType> input_storage_;
+  std::span<const InOutType> input_;
   InOutType max;
   IndexType max_index;
 };
@@ -5,11 +5,11 @@
 
 #include <gtest/gtest.h>
 
-#include <algorithm>
 #include <memory>
-#include <numeric>
+#include <span>
 #include <vector>
 
+#include "core/simd/include/simd.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -22,11 +22,7 @@ class MinOfVectorElements : public ppc::core::Task {
   bool pre_processing() override {
     internal_order_test();
     // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = acquire_input(0, input_storage_);
     // Init value for output
     min = 0.0;
     min_index = 0;
@@ -46,9 +42,10 @@ class MinOfVectorElements : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    auto result = std::min_element(input_.begin(), input_.end());
-    min = static_cast<InOutType>(*result);
-    min_index = static_cast<IndexType>(std::distance(input_.begin(), result));
+    // first smallest element as std::min_element finds it
+    auto index = ppc::core::simd::min_index(input_);
+    min = static_cast<InOutType>(input_[index]);
+    min_index = static_cast<IndexType>(index);
     return true;
   }
 
@@ -60,7 +57,8 @@ class MinOfVectorElements : public ppc::core::Task {
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::vector<InOutType> input_storage_;
+  std::span<const InOutType> input_;
   InOutType min;
   IndexType min_index;
 };
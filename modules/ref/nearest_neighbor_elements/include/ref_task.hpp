@@ -5,12 +5,13 @@
 
 #include <gtest/gtest.h>
 
-#include <algorithm>
+#include <cstdlib>
 #include <functional>
 #include <memory>
-#include <numeric>
+#include <span>
 #include <vector>
 
+#include "core/algorithms/include/adjacent.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -23,11 +24,7 @@ class NearestNeighborElements : public ppc::core::Task {
   bool pre_processing() override {
     internal_order_test();
     // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = acquire_input(0, input_storage_);
     // Init value for output
     l_elem = r_elem = 0;
     l_elem_index = r_elem_index = 0;
@@ -42,16 +39,10 @@ class NearestNeighborElements : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    auto rotate_in = input_;
-    int rot_left = 1;
-    rotate(rotate_in.begin(), rotate_in.begin() + rot_left, rotate_in.end());
-
-    auto temp_res = std::vector<InOutType>(input_.size());
-    std::transform(input_.begin(), input_.end(), rotate_in.begin(), temp_res.begin(),
-                   [](InOutType x, InOutType y) { return std::abs(x - y); });
-
-    auto result = std::min_element(temp_res.begin(), temp_res.end() - 1);
-    l_elem_index = static_cast<IndexType>(std::distance(temp_res.begin(), result));
+    // first pair with smallest difference, as std::min_element over differences would find it
+    auto result = ppc::core::extremum_adjacent_by(
+        input_, [](InOutType x, InOutType y) { return static_cast<InOutType>(std::abs(x - y)); }, std::less<>());
+    l_elem_index = static_cast<IndexType>(result.index);
     l_elem = input_[l_elem_index];
 
     r_elem_index = l_elem_index + 1;
@@ -69,7 +60,8 @@ class NearestNeighborElements : public ppc::core::Task {
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::vector<InOutType> input_storage_;
+  std::span<const InOutType> input_;
   InOutType l_elem, r_elem;
   IndexType l_elem_index, r_elem_index;
 };
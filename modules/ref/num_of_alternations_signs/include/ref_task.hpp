@@ -5,12 +5,11 @@
 
 #include <gtest/gtest.h>
 
-#include <algorithm>
-#include <functional>
 #include <memory>
-#include <numeric>
+#include <span>
 #include <vector>
 
+#include "core/algorithms/include/adjacent.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -23,11 +22,7 @@ class NumOfAlternationsSigns : public ppc::core::Task {
   bool pre_processing() override {
     internal_order_test();
     // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = acquire_input(0, input_storage_);
     // Init value for output
     num = 0;
     return true;
@@ -41,14 +36,10 @@ class NumOfAlternationsSigns : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    auto rotate_in = input_;
-    int rot_left = 1;
-    rotate(rotate_in.begin(), rotate_in.begin() + rot_left, rotate_in.end());
-
-    auto temp_res = input_;
-    std::transform(input_.begin(), input_.end(), rotate_in.begin(), temp_res.begin(), std::multiplies<>());
-
-    num = std::count_if(temp_res.begin(), temp_res.end() - 1, [](InOutType elem) { return elem < 0; });
+    // signs are compared instead of checking sign of product, which could overflow
+    num = static_cast<CountType>(ppc::core::count_adjacent_if(input_, [](InOutType left, InOutType right) {
+      return (left < 0 && right > 0) || (left > 0 && right < 0);
+    }));
     return true;
   }
 
@@ -59,7 +50,8 @@ class NumOfAlternationsSigns : public ppc::core::Task {
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::vector<InOutType> input_storage_;
+  std::span<const InOutType> input_;
   CountType num;
 };
 
@@ -2,8 +2,11 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <memory>
+#include <span>
 #include <vector>
 
+#include "core/task/include/streaming_task.hpp"
 #include "core/task/include/task.hpp"
 #include "ref/num_of_orderly_violations/include/ref_task.hpp"
 
@@ -144,3 +147,40 @@ TEST(num_of_orderly_violations, check_float) {
   testTask.post_processing();
   ASSERT_EQ(out[0], 1ull);
 }
+
+TEST(num_of_orderly_violations, check_streaming_matches_resident) {
+  // Create data, violations fall on borders of chunks too
+  std::vector<int32_t> in(10000);
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = static_cast<int32_t>((i * 7919) % 64);
+  }
+  std::vector<uint64_t> out(1, 0);
+  std::vector<uint64_t> out_streaming(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  std::shared_ptr<ppc::core::TaskData> taskDataStreaming = std::make_shared<ppc::core::TaskData>();
+  taskDataStreaming->outputs.emplace_back(reinterpret_cast<uint8_t*>(out_streaming.data()));
+  taskDataStreaming->outputs_count.emplace_back(out_streaming.size());
+
+  // Create Tasks
+  ppc::reference::NumOfOrderlyViolations<int32_t, uint64_t> testTask(taskData);
+  ASSERT_EQ(testTask.validation(), true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+
+  for (size_t chunk_size : {1, 7, 64, 20000}) {
+    auto source = std::make_shared<ppc::core::SpanChunkSource<int32_t>>(std::span<const int32_t>(in), chunk_size);
+    ppc::reference::NumOfOrderlyViolationsStreaming<int32_t, uint64_t> streamingTask(taskDataStreaming, source);
+    ASSERT_EQ(streamingTask.validation(), true);
+    streamingTask.pre_processing();
+    streamingTask.run();
+    streamingTask.post_processing();
+    ASSERT_EQ(out_streaming[0], out[0]) << "chunks of " << chunk_size;
+  }
+}
@@ -5,12 +5,12 @@
 
 #include <gtest/gtest.h>
 
-#include <algorithm>
-#include <functional>
 #include <memory>
-#include <numeric>
+#include <span>
 #include <vector>
 
+#include "core/algorithms/include/adjacent.hpp"
+#include "core/task/include/streaming_task.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -23,11 +23,7 @@ class NumOfOrderlyViolations : public ppc::core::Task {
   bool pre_processing() override {
     internal_order_test();
     // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = acquire_input(0, input_storage_);
     // Init value for output
     num = 0;
     return true;
@@ -41,15 +37,8 @@ class NumOfOrderlyViolations : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    auto rotate_in = input_;
-    int rot_left = 1;
-    rotate(rotate_in.begin(), rotate_in.begin() + rot_left, rotate_in.end());
-
-    auto temp_res = std::vector<bool>(input_.size());
-    std::transform(input_.begin(), input_.end(), rotate_in.begin(), temp_res.begin(),
-                   [](InOutType x, InOutType y) { return x > y; });
-
-    num = std::count_if(temp_res.begin(), temp_res.end() - 1, [](InOutType elem) { return elem; });
+    num = static_cast<CountType>(
+        ppc::core::count_adjacent_if(input_, [](InOutType left, InOutType right) { return left > right; }));
     return true;
   }
 
@@ -60,10 +49,57 @@ class NumOfOrderlyViolations : public ppc::core::Task {
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::vector<InOutType> input_storage_;
+  std::span<const InOutType> input_;
   CountType num;
 };
 
+// Count of violations in input streamed from a chunk source: the pair crossing the border of
+// chunks is checked with the last element of previous chunk kept in running state
+template <class InOutType, class CountType>
+class NumOfOrderlyViolationsStreaming : public ppc::core::StreamingTask<InOutType> {
+ public:
+  using ppc::core::StreamingTask<InOutType>::StreamingTask;
+  bool pre_processing() override {
+    this->internal_order_test();
+    return true;
+  }
+
+  bool validation() override {
+    this->internal_order_test();
+    // Check count elements of output
+    return this->taskData->outputs_count[0] == 1;
+  }
+
+  bool post_processing() override {
+    this->internal_order_test();
+    reinterpret_cast<CountType*>(this->taskData->outputs[0])[0] = num;
+    return true;
+  }
+
+ protected:
+  void reset_state() override {
+    num = 0;
+    has_last = false;
+  }
+
+  bool consume(std::span<const InOutType> chunk) override {
+    auto descending = [](InOutType left, InOutType right) { return left > right; };
+    if (has_last && descending(last, chunk.front())) {
+      num++;
+    }
+    num += static_cast<CountType>(ppc::core::count_adjacent_if(chunk, descending));
+    last = chunk.back();
+    has_last = true;
+    return true;
+  }
+
+ private:
+  CountType num{};
+  InOutType last{};
+  bool has_last = false;
+};
+
 }  // namespace reference
 }  // namespace ppc
 
@@ -1,8 +1,12 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <numeric>
+#include <span>
 #include <vector>
 
+#include "core/task/include/streaming_task.hpp"
 #include "core/task/include/task.hpp"
 #include "ref/sum_of_vector_elements/include/ref_task.hpp"
 
@@ -26,6 +30,27 @@ TEST(sum_of_vector_elements, check_int32_t) {
   ASSERT_EQ(static_cast<uint64_t>(out[0]), in.size());
 }
 
+TEST(sum_of_vector_elements, check_borrowed_inputs) {
+  // Create data
+  std::vector<int32_t> in(1256, 1);
+  std::vector<int32_t> out(1, 0);
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  taskData->borrow_inputs = true;
+  // Create Task
+  ppc::reference::SumOfVectorElements<int32_t> testTask(taskData);
+  bool isValid = testTask.validation();
+  ASSERT_EQ(isValid, true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+  ASSERT_EQ(static_cast<uint64_t>(out[0]), in.size());
+}
+
 TEST(sum_of_vector_elements, check_validate_func) {
   // Create data
   std::vector<int32_t> in(125, 1);
@@ -121,3 +146,25 @@ TEST(sum_of_vector_elements, check_float) {
   testTask.post_processing();
   EXPECT_NEAR(out[0], static_cast<float>(in.size()), 1e-3f);
 }
+
+TEST(sum_of_vector_elements, check_streaming_generated_input) {
+  // Create data, input is generated chunk by chunk and never resident as a whole
+  const uint64_t count = 1 << 20;
+  std::vector<int64_t> out(1, 0);
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  auto source = std::make_shared<ppc::core::GeneratorChunkSource<int64_t>>(
+      count, 1 << 12, [](std::span<int64_t> chunk, uint64_t offset) {
+        std::iota(chunk.begin(), chunk.end(), static_cast<int64_t>(offset));
+      });
+  // Create Task
+  ppc::reference::SumOfVectorElementsStreaming<int64_t> testTask(taskData, source);
+  bool isValid = testTask.validation();
+  ASSERT_EQ(isValid, true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+  ASSERT_EQ(static_cast<uint64_t>(out[0]), count * (count - 1) / 2);
+}
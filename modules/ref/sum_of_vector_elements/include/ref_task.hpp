@@ -5,9 +5,11 @@
 #include <gtest/gtest.h>
 
 #include <memory>
-#include <numeric>
+#include <span>
 #include <vector>
 
+#include "core/simd/include/simd.hpp"
+#include "core/task/include/streaming_task.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc::reference {
@@ -19,11 +21,7 @@ class SumOfVectorElements : public ppc::core::Task {
   bool pre_processing() override {
     internal_order_test();
     // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = acquire_input(0, input_storage_);
     // Init value for output
     sum = 0;
     return true;
@@ -37,7 +35,8 @@ class SumOfVectorElements : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    sum = std::accumulate(input_.begin(), input_.end(), 0);
+    // vectorized with several accumulators, integers are summed in 64 bits and wrap only on the final cast
+    sum = static_cast<InOutType>(ppc::core::simd::sum(input_));
     return true;
   }
 
@@ -48,8 +47,43 @@ class SumOfVectorElements : public ppc::core::Task {
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::vector<InOutType> input_storage_;
+  std::span<const InOutType> input_;
   InOutType sum;
 };
 
+// Sum of input streamed from a chunk source, which may be larger than memory
+template <class InOutType>
+class SumOfVectorElementsStreaming : public ppc::core::StreamingTask<InOutType> {
+ public:
+  using ppc::core::StreamingTask<InOutType>::StreamingTask;
+  bool pre_processing() override {
+    this->internal_order_test();
+    return true;
+  }
+
+  bool validation() override {
+    this->internal_order_test();
+    // Check count elements of output
+    return this->taskData->outputs_count[0] == 1;
+  }
+
+  bool post_processing() override {
+    this->internal_order_test();
+    reinterpret_cast<InOutType*>(this->taskData->outputs[0])[0] = static_cast<InOutType>(sum);
+    return true;
+  }
+
+ protected:
+  void reset_state() override { sum = 0; }
+
+  bool consume(std::span<const InOutType> chunk) override {
+    sum += ppc::core::simd::sum(chunk);
+    return true;
+  }
+
+ private:
+  ppc::core::simd::accumulator_t<InOutType> sum{};
+};
+
 }  // namespace ppc::reference
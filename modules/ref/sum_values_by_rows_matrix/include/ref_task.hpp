@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
 #include "core/task/include/task.hpp"
@@ -21,11 +22,7 @@ class SumValuesByRowsMatrix : public ppc::core::Task {
   bool pre_processing() override {
     internal_order_test();
     // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = acquire_input(0, input_storage_);
     rows = reinterpret_cast<IndexType*>(taskData->inputs[1])[0];
     cols = reinterpret_cast<IndexType*>(taskData->inputs[1])[1];
 
@@ -58,7 +55,8 @@ class SumValuesByRowsMatrix : public ppc::core::Task {
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::vector<InOutType> input_storage_;
+  std::span<const InOutType> input_;
   IndexType rows, cols;
   std::vector<InOutType> sum_;
 };
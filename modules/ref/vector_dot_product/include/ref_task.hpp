@@ -5,10 +5,13 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
 #include <memory>
-#include <numeric>
+#include <span>
+#include <type_traits>
 #include <vector>
 
+#include "core/simd/include/simd.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -21,13 +24,8 @@ class VectorDotProduct : public ppc::core::Task {
   bool pre_processing() override {
     internal_order_test();
     // Init vectors
-    input_ = std::vector<std::vector<InOutType> >(2);
     for (size_t i = 0; i < input_.size(); i++) {
-      input_[i] = std::vector<InOutType>(taskData->inputs_count[i]);
-      auto tmp_ptr_ = reinterpret_cast<InOutType*>(taskData->inputs[i]);
-      for (unsigned j = 0; j < taskData->inputs_count[i]; j++) {
-        input_[i][j] = tmp_ptr_[j];
-      }
+      input_[i] = acquire_input(i, input_storage_[i]);
     }
 
     // Init value for output
@@ -43,7 +41,7 @@ class VectorDotProduct : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    dor_product = std::inner_product(input_[0].begin(), input_[0].end(), input_[1].begin(), 0.0);
+    dor_product = static_cast<InOutType>(ppc::core::simd::dot<Accumulator>(input_[0], input_[1]));
     return true;
   }
 
@@ -54,7 +52,11 @@ class VectorDotProduct : public ppc::core::Task {
   }
 
  private:
-  std::vector<std::vector<InOutType> > input_;
+  // floating point products are summed in double, integer ones exactly in 64 bits
+  using Accumulator =
+      std::conditional_t<std::is_floating_point_v<InOutType>, double, ppc::core::simd::accumulator_t<InOutType>>;
+  std::array<std::vector<InOutType>, 2> input_storage_;
+  std::array<std::span<const InOutType>, 2> input_;
   InOutType dor_product;
 };
 
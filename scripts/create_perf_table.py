@@ -85,3 +85,43 @@ for table_name in result_tables:
         it_i = 1
         it_j += 1
     workbook.close()
+
+scaling_tables = {}
+for line in logs_lines:
+    pattern = r'tasks[\/|\\](\w*)[\/|\\](\w*):scaling:(\d+):(-*\d*\.\d*):(-*\d*\.\d*):(-*\d*\.\d*)'
+    result = re.findall(pattern, line)
+    if len(result):
+        task_type = result[0][0]
+        task_name = result[0][1]
+        num_threads = int(result[0][2])
+        point = [float(value) for value in result[0][3:]]
+        scaling_tables.setdefault((task_name, task_type), {})[num_threads] = point
+
+if len(scaling_tables):
+    workbook = xlsxwriter.Workbook(os.path.join(xlsx_path, 'scaling_perf_table.xlsx'))
+    worksheet = workbook.add_worksheet()
+    worksheet.set_column('A:ZZ', 15)
+    right_bold_border = workbook.add_format({'bold': True, 'right': 2, 'bottom': 2})
+    bottom_bold_border = workbook.add_format({'bold': True, 'bottom': 2})
+    right_border = workbook.add_format({'right': 2})
+    thread_counts = sorted(set(num_threads for curve in scaling_tables.values() for num_threads in curve))
+    worksheet.write(0, 0, "task", right_bold_border)
+    it = 1
+    for num_threads in thread_counts:
+        worksheet.write(0, it, "T(" + str(num_threads) + ")", bottom_bold_border)
+        worksheet.write(0, it + 1, "S(" + str(num_threads) + ")", bottom_bold_border)
+        worksheet.write(0, it + 2, "Eff(" + str(num_threads) + ")", right_bold_border)
+        it += 3
+
+    it_j = 1
+    for (task_name, task_type), curve in sorted(scaling_tables.items()):
+        worksheet.write(it_j, 0, task_name + " (" + task_type + ")", workbook.add_format({'bold': True, 'right': 2}))
+        it_i = 1
+        for num_threads in thread_counts:
+            par_time, speed_up, efficiency = curve.get(num_threads, [-1.0, -1.0, -1.0])
+            worksheet.write(it_j, it_i, par_time)
+            worksheet.write(it_j, it_i + 1, speed_up)
+            worksheet.write(it_j, it_i + 2, efficiency, right_border)
+            it_i += 3
+        it_j += 1
+    workbook.close()
@@ -1,10 +1,21 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <boost/mpi/communicator.hpp>
 #include <boost/mpi/environment.hpp>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "core/mpi/include/overlap.hpp"
+#include "core/mpi/include/partition.hpp"
+#include "core/mpi/include/patterns_mpi.hpp"
+#include "core/mpi/include/scatter.hpp"
+#include "core/mpi/include/trace_mpi.hpp"
 #include "mpi/example/include/ops_mpi.hpp"
 
 TEST(Parallel_Operations_MPI, Test_Sum) {
@@ -227,6 +238,241 @@ TEST(Parallel_Operations_MPI, Test_Max_2) {
   }
 }
 
+TEST(Parallel_Operations_MPI, Test_Sum_Not_Divisible) {
+  boost::mpi::communicator world;
+  std::vector<int> global_vec;
+  std::vector<int32_t> global_sum(1, 0);
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+
+  if (world.rank() == 0) {
+    const int count_size_vector = 7 * world.size() + 3;
+    global_vec = std::vector<int>(count_size_vector, 1);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
+    taskDataPar->inputs_count.emplace_back(global_vec.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_sum.data()));
+    taskDataPar->outputs_count.emplace_back(global_sum.size());
+  }
+
+  nesterov_a_test_task_mpi::TestMPITaskParallel testMpiTaskParallel(taskDataPar, "+");
+  ASSERT_EQ(testMpiTaskParallel.validation(), true);
+  testMpiTaskParallel.pre_processing();
+  testMpiTaskParallel.run();
+  testMpiTaskParallel.post_processing();
+
+  if (world.rank() == 0) {
+    ASSERT_EQ(static_cast<int32_t>(global_vec.size()), global_sum[0]);
+  }
+}
+
+TEST(Parallel_Operations_MPI, Test_Max_Less_Elements_Than_Ranks) {
+  boost::mpi::communicator world;
+  std::vector<int> global_vec;
+  std::vector<int32_t> global_max(1, 0);
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+
+  if (world.rank() == 0) {
+    global_vec = {-5};
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
+    taskDataPar->inputs_count.emplace_back(global_vec.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_max.data()));
+    taskDataPar->outputs_count.emplace_back(global_max.size());
+  }
+
+  nesterov_a_test_task_mpi::TestMPITaskParallel testMpiTaskParallel(taskDataPar, "max");
+  ASSERT_EQ(testMpiTaskParallel.validation(), true);
+  testMpiTaskParallel.pre_processing();
+  testMpiTaskParallel.run();
+  testMpiTaskParallel.post_processing();
+
+  if (world.rank() == 0) {
+    ASSERT_EQ(-5, global_max[0]);
+  }
+}
+
+TEST(Parallel_Operations_MPI, Test_Scatter_Balanced) {
+  boost::mpi::communicator world;
+  for (bool in_place : {false, true}) {
+    const size_t total = 5 * world.size() + 2;
+    std::vector<int> global_vec(total);
+    std::iota(global_vec.begin(), global_vec.end(), 0);
+    std::span<const int> root_data;
+    if (world.rank() == 0) {
+      root_data = global_vec;
+    }
+
+    auto block = ppc::core::scatter_balanced(world, root_data, 0, in_place);
+    ppc::core::BlockPartition partition(total, world.size());
+    ASSERT_EQ(block.total, total);
+    ASSERT_EQ(block.offset, static_cast<size_t>(partition.displacements[world.rank()]));
+    ASSERT_EQ(block.data.size(), static_cast<size_t>(partition.counts[world.rank()]));
+    for (size_t i = 0; i < block.data.size(); i++) {
+      ASSERT_EQ(block.data[i], static_cast<int>(block.offset + i));
+    }
+    if (world.rank() == 0 && in_place) {
+      EXPECT_TRUE(block.storage.empty());
+      EXPECT_EQ(block.data.data(), global_vec.data());
+    }
+    // moved block keeps viewing its own storage
+    const int *viewed = block.data.data();
+    auto moved = std::move(block);
+    EXPECT_EQ(moved.data.data(), viewed);
+  }
+}
+
+TEST(Parallel_Operations_MPI, Test_Sum_Borrowed_Inputs) {
+  boost::mpi::communicator world;
+  std::vector<int> global_vec;
+  std::vector<int32_t> global_sum(1, 0);
+  // Create TaskData, root keeps its block in place
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  taskDataPar->borrow_inputs = true;
+
+  if (world.rank() == 0) {
+    const int count_size_vector = 121;
+    global_vec = std::vector<int>(count_size_vector, 2);
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
+    taskDataPar->inputs_count.emplace_back(global_vec.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_sum.data()));
+    taskDataPar->outputs_count.emplace_back(global_sum.size());
+  }
+
+  nesterov_a_test_task_mpi::TestMPITaskParallel testMpiTaskParallel(taskDataPar, "+");
+  ASSERT_EQ(testMpiTaskParallel.validation(), true);
+  testMpiTaskParallel.pre_processing();
+  testMpiTaskParallel.run();
+  testMpiTaskParallel.post_processing();
+
+  if (world.rank() == 0) {
+    ASSERT_EQ(242, global_sum[0]);
+  }
+}
+
+TEST(Parallel_Operations_MPI, Test_Overlapped_Chunks) {
+  boost::mpi::communicator world;
+  for (const std::string ops : {"+", "-", "max"}) {
+    for (int num_chunks : {2, 3, 16}) {
+      std::vector<int> global_vec;
+      std::vector<int32_t> global_res(1, 0);
+      // Create TaskData
+      std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+
+      if (world.rank() == 0) {
+        const int count_size_vector = 13 * world.size() + 5;
+        global_vec = nesterov_a_test_task_mpi::getRandomVector(count_size_vector);
+        taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
+        taskDataPar->inputs_count.emplace_back(global_vec.size());
+        taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_res.data()));
+        taskDataPar->outputs_count.emplace_back(global_res.size());
+      }
+
+      nesterov_a_test_task_mpi::TestMPITaskParallel testMpiTaskParallel(taskDataPar, ops, num_chunks);
+      ASSERT_EQ(testMpiTaskParallel.validation(), true);
+      testMpiTaskParallel.pre_processing();
+      testMpiTaskParallel.run();
+      testMpiTaskParallel.post_processing();
+
+      if (world.rank() == 0) {
+        // Create data
+        std::vector<int32_t> reference_res(1, 0);
+
+        // Create TaskData
+        std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+        taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
+        taskDataSeq->inputs_count.emplace_back(global_vec.size());
+        taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t*>(reference_res.data()));
+        taskDataSeq->outputs_count.emplace_back(reference_res.size());
+
+        // Create Task
+        nesterov_a_test_task_mpi::TestMPITaskSequential testMpiTaskSequential(taskDataSeq, ops);
+        ASSERT_EQ(testMpiTaskSequential.validation(), true);
+        testMpiTaskSequential.pre_processing();
+        testMpiTaskSequential.run();
+        testMpiTaskSequential.post_processing();
+
+        ASSERT_EQ(reference_res[0], global_res[0]) << "ops " << ops << ", chunks " << num_chunks;
+      }
+    }
+  }
+}
+
+TEST(Parallel_Operations_MPI, Test_Scatter_Reduce_Overlapped) {
+  boost::mpi::communicator world;
+  const size_t total = 1000;
+  std::vector<long> global_vec(total);
+  std::iota(global_vec.begin(), global_vec.end(), 1);
+  std::span<const long> root_data;
+  if (world.rank() == 0) {
+    root_data = global_vec;
+  }
+  auto chunk_sum = [](std::span<const long> block, long init) {
+    return std::accumulate(block.begin(), block.end(), init);
+  };
+  for (bool in_place : {false, true}) {
+    // more chunks than elements on some ranks leaves empty blocks
+    for (int num_chunks : {1, 4, 1500}) {
+      auto sum = ppc::core::scatter_reduce_overlapped(world, root_data, num_chunks, 0L, chunk_sum, std::plus<long>(), 0,
+                                                      in_place);
+      if (world.rank() == 0) {
+        ASSERT_EQ(sum, 500500L);
+      } else {
+        ASSERT_EQ(sum, 0L);
+      }
+    }
+  }
+}
+
+TEST(Parallel_Operations_MPI, Test_Patterns) {
+  boost::mpi::communicator world;
+  // fewer elements than ranks leaves some blocks empty
+  for (size_t total : {size_t{0}, size_t{3}, 7 * static_cast<size_t>(world.size()) + 2}) {
+    std::vector<int> global_vec(total);
+    std::iota(global_vec.begin(), global_vec.end(), 1);
+    std::span<const int> root_data;
+    std::vector<int> out(total, -1);
+    if (world.rank() == 0) {
+      root_data = global_vec;
+    }
+    ppc::patterns::Mpi policy{world};
+
+    auto sum = ppc::patterns::reduce(policy, root_data, 0, std::plus<>());
+    ASSERT_EQ(sum, static_cast<int>(total * (total + 1) / 2));
+    // concatenation of decimal numbers isn't commutative, blocks have to be combined in order of ranks
+    auto concat = [](long long left, long long right) {
+      for (auto rest = right; rest > 0; rest /= 10) {
+        left *= 10;
+      }
+      return left + right;
+    };
+    auto count = std::min<size_t>(total, 9);
+    auto digits = ppc::patterns::map_reduce(
+        policy, root_data.first(world.rank() == 0 ? count : 0), 0LL,
+        [](int value) { return static_cast<long long>(value); }, concat);
+    ASSERT_EQ(digits, std::accumulate(global_vec.begin(), global_vec.begin() + count, 0LL, concat));
+
+    ppc::patterns::inclusive_scan(policy, root_data, std::span<int>(out), 0, std::plus<>());
+    if (world.rank() == 0) {
+      for (size_t i = 0; i < total; i++) {
+        ASSERT_EQ(out[i], static_cast<int>((i + 1) * (i + 2) / 2));
+      }
+    }
+
+    ppc::patterns::map(policy, root_data, std::span<int>(out), [](int value) { return 2 * value; });
+    ppc::patterns::stencil(policy, root_data, std::span<int>(out), 1,
+                           [](std::span<const int> window) { return window[0] + window[1] + window[2]; });
+    if (world.rank() == 0) {
+      for (size_t i = 0; i < total; i++) {
+        // stencil leaves borders written by map untouched
+        auto inner = i > 0 && i + 1 < total;
+        ASSERT_EQ(out[i], inner ? 3 * global_vec[i] : 2 * global_vec[i]) << "index " << i;
+      }
+    } else {
+      ASSERT_EQ(out, std::vector<int>(total, -1));
+    }
+  }
+}
+
 int main(int argc, char** argv) {
   boost::mpi::environment env(argc, argv);
   boost::mpi::communicator world;
@@ -235,5 +481,7 @@ int main(int argc, char** argv) {
   if (world.rank() != 0) {
     delete listeners.Release(listeners.default_result_printer());
   }
-  return RUN_ALL_TESTS();
+  auto result = RUN_ALL_TESTS();
+  ppc::core::write_trace(world);
+  return result;
 }
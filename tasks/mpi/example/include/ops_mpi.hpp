@@ -7,10 +7,13 @@
 #include <boost/mpi/communicator.hpp>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "core/mpi/include/overlap.hpp"
+#include "core/mpi/include/patterns_mpi.hpp"
 #include "core/task/include/task.hpp"
 
 namespace nesterov_a_test_task_mpi {
@@ -27,24 +30,31 @@ class TestMPITaskSequential : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::vector<int> input_storage_;
+  std::span<const int> input_;
   int res{};
   std::string ops;
 };
 
 class TestMPITaskParallel : public ppc::core::Task {
  public:
-  explicit TestMPITaskParallel(std::shared_ptr<ppc::core::TaskData> taskData_, std::string ops_)
-      : Task(std::move(taskData_)), ops(std::move(ops_)) {}
+  // With num_chunks_ > 1 input is streamed during run() in chunks by nonblocking collectives,
+  // so ranks compute on received chunks while next ones are still being transferred
+  explicit TestMPITaskParallel(std::shared_ptr<ppc::core::TaskData> taskData_, std::string ops_, int num_chunks_ = 1)
+      : Task(std::move(taskData_)), ops(std::move(ops_)), num_chunks(num_chunks_) {}
   bool pre_processing() override;
   bool validation() override;
   bool run() override;
   bool post_processing() override;
 
  private:
-  std::vector<int> input_, local_input_;
+  int reduce_block(std::span<const int> block, int init) const;
+
+  std::vector<int> root_input_storage_;
+  std::span<const int> root_input_;
   int res{};
   std::string ops;
+  int num_chunks;
   boost::mpi::communicator world;
 };
 
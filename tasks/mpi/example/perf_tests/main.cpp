@@ -1,9 +1,10 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
-#include <boost/mpi/timer.hpp>
 #include <vector>
 
+#include "core/mpi/include/perf_mpi.hpp"
+#include "core/mpi/include/trace_mpi.hpp"
 #include "core/perf/include/perf.hpp"
 #include "mpi/example/include/ops_mpi.hpp"
 
@@ -15,7 +16,7 @@ TEST(mpi_example_perf_test, test_pipeline_run) {
   std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
   int count_size_vector;
   if (world.rank() == 0) {
-    count_size_vector = 120;
+    count_size_vector = 1 << 24;
     global_vec = std::vector<int>(count_size_vector, 1);
     taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
     taskDataPar->inputs_count.emplace_back(global_vec.size());
@@ -31,9 +32,8 @@ TEST(mpi_example_perf_test, test_pipeline_run) {
 
   // Create Perf attributes
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-  perfAttr->num_running = 10;
-  const boost::mpi::timer current_timer;
-  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  // Barrier-aligned timing with per-rank times gathered
+  ppc::core::synchronize_ranks(*perfAttr, world);
 
   // Create and init perf results
   auto perfResults = std::make_shared<ppc::core::PerfResults>();
@@ -41,6 +41,7 @@ TEST(mpi_example_perf_test, test_pipeline_run) {
   // Create Perf analyzer
   auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
   perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  ASSERT_EQ(perfResults->ranks.per_rank.size(), static_cast<size_t>(world.size()));
   if (world.rank() == 0) {
     ppc::core::Perf::print_perf_statistic(perfResults);
     ASSERT_EQ(count_size_vector, global_sum[0]);
@@ -55,7 +56,7 @@ TEST(mpi_example_perf_test, test_task_run) {
   std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
   int count_size_vector;
   if (world.rank() == 0) {
-    count_size_vector = 120;
+    count_size_vector = 1 << 24;
     global_vec = std::vector<int>(count_size_vector, 1);
     taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
     taskDataPar->inputs_count.emplace_back(global_vec.size());
@@ -63,7 +64,8 @@ TEST(mpi_example_perf_test, test_task_run) {
     taskDataPar->outputs_count.emplace_back(global_sum.size());
   }
 
-  auto testMpiTaskParallel = std::make_shared<nesterov_a_test_task_mpi::TestMPITaskParallel>(taskDataPar, "+");
+  // Input is streamed in chunks inside run(), so transfers are measured and overlapped with computation
+  auto testMpiTaskParallel = std::make_shared<nesterov_a_test_task_mpi::TestMPITaskParallel>(taskDataPar, "+", 8);
   ASSERT_EQ(testMpiTaskParallel->validation(), true);
   testMpiTaskParallel->pre_processing();
   testMpiTaskParallel->run();
@@ -71,9 +73,8 @@ TEST(mpi_example_perf_test, test_task_run) {
 
   // Create Perf attributes
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-  perfAttr->num_running = 10;
-  const boost::mpi::timer current_timer;
-  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  // Barrier-aligned timing with per-rank times gathered
+  ppc::core::synchronize_ranks(*perfAttr, world);
 
   // Create and init perf results
   auto perfResults = std::make_shared<ppc::core::PerfResults>();
@@ -81,6 +82,7 @@ TEST(mpi_example_perf_test, test_task_run) {
   // Create Perf analyzer
   auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testMpiTaskParallel);
   perfAnalyzer->task_run(perfAttr, perfResults);
+  ASSERT_EQ(perfResults->ranks.per_rank.size(), static_cast<size_t>(world.size()));
   if (world.rank() == 0) {
     ppc::core::Perf::print_perf_statistic(perfResults);
     ASSERT_EQ(count_size_vector, global_sum[0]);
@@ -95,5 +97,7 @@ int main(int argc, char** argv) {
   if (world.rank() != 0) {
     delete listeners.Release(listeners.default_result_printer());
   }
-  return RUN_ALL_TESTS();
+  auto result = RUN_ALL_TESTS();
+  ppc::core::write_trace(world);
+  return result;
 }
@@ -3,31 +3,20 @@
 
 #include <algorithm>
 #include <functional>
-#include <random>
+#include <limits>
 #include <string>
-#include <thread>
 #include <vector>
 
-using namespace std::chrono_literals;
+#include "core/random/include/random.hpp"
 
 std::vector<int> nesterov_a_test_task_mpi::getRandomVector(int sz) {
-  std::random_device dev;
-  std::mt19937 gen(dev());
-  std::vector<int> vec(sz);
-  for (int i = 0; i < sz; i++) {
-    vec[i] = gen() % 100;
-  }
-  return vec;
+  return ppc::core::random_vector<int>(sz, 0, 99);
 }
 
 bool nesterov_a_test_task_mpi::TestMPITaskSequential::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_ = acquire_input(0, input_storage_);
   // Init value for output
   res = 0;
   return true;
@@ -59,28 +48,9 @@ bool nesterov_a_test_task_mpi::TestMPITaskSequential::post_processing() {
 
 bool nesterov_a_test_task_mpi::TestMPITaskParallel::pre_processing() {
   internal_order_test();
-  unsigned int delta = 0;
-  if (world.rank() == 0) {
-    delta = taskData->inputs_count[0] / world.size();
-  }
-  broadcast(world, delta, 0);
-
+  // Input is distributed in run(), by chunks overlapped with computation or by the reduce pattern
   if (world.rank() == 0) {
-    // Init vectors
-    input_ = std::vector<int>(taskData->inputs_count[0]);
-    auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
-    for (int proc = 1; proc < world.size(); proc++) {
-      world.send(proc, 0, input_.data() + proc * delta, delta);
-    }
-  }
-  local_input_ = std::vector<int>(delta);
-  if (world.rank() == 0) {
-    local_input_ = std::vector<int>(input_.begin(), input_.begin() + delta);
-  } else {
-    world.recv(0, 0, local_input_.data(), delta);
+    root_input_ = acquire_input(0, root_input_storage_);
   }
   // Init value for output
   res = 0;
@@ -96,23 +66,38 @@ bool nesterov_a_test_task_mpi::TestMPITaskParallel::validation() {
   return true;
 }
 
-bool nesterov_a_test_task_mpi::TestMPITaskParallel::run() {
-  internal_order_test();
-  int local_res;
+int nesterov_a_test_task_mpi::TestMPITaskParallel::reduce_block(std::span<const int> block, int init) const {
   if (ops == "+") {
-    local_res = std::accumulate(local_input_.begin(), local_input_.end(), 0);
-  } else if (ops == "-") {
-    local_res = -std::accumulate(local_input_.begin(), local_input_.end(), 0);
-  } else if (ops == "max") {
-    local_res = *std::max_element(local_input_.begin(), local_input_.end());
+    return init + std::accumulate(block.begin(), block.end(), 0);
   }
+  if (ops == "-") {
+    return init - std::accumulate(block.begin(), block.end(), 0);
+  }
+  // ranks left without elements when there are more ranks than elements
+  return block.empty() ? init : std::max(init, *std::max_element(block.begin(), block.end()));
+}
 
+bool nesterov_a_test_task_mpi::TestMPITaskParallel::run() {
+  internal_order_test();
+  auto reduce_chunk = [this](std::span<const int> block, int init) { return reduce_block(block, init); };
+  const ppc::patterns::Mpi<> policy{world};
   if (ops == "+" || ops == "-") {
-    reduce(world, local_res, res, std::plus(), 0);
+    if (num_chunks > 1) {
+      res = ppc::core::scatter_reduce_overlapped(world, root_input_, num_chunks, 0, reduce_chunk, std::plus<int>(),
+                                                 0, true);
+    } else {
+      auto sum = ppc::patterns::reduce(policy, root_input_, 0, std::plus<>());
+      res = ops == "-" ? -sum : sum;
+    }
   } else if (ops == "max") {
-    reduce(world, local_res, res, boost::mpi::maximum<int>(), 0);
+    const int identity = std::numeric_limits<int>::min();
+    if (num_chunks > 1) {
+      res = ppc::core::scatter_reduce_overlapped(world, root_input_, num_chunks, identity, reduce_chunk,
+                                                 boost::mpi::maximum<int>(), 0, true);
+    } else {
+      res = ppc::patterns::reduce(policy, root_input_, identity, [](int a, int b) { return std::max(a, b); });
+    }
   }
-  std::this_thread::sleep_for(20ms);
   return true;
 }
 
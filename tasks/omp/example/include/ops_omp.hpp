@@ -1,9 +1,11 @@
 // Copyright 2023 Nesterov Alexander
 #pragma once
 
+#include <span>
 #include <string>
 #include <vector>
 
+#include "core/backend/include/backend.hpp"
 #include "core/task/include/task.hpp"
 
 namespace nesterov_a_test_task_omp {
@@ -20,7 +22,8 @@ class TestOMPTaskSequential : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::vector<int> input_storage_;
+  std::span<const int> input_;
   int res{};
   std::string ops;
 };
@@ -35,9 +38,13 @@ class TestOMPTaskParallel : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::vector<int> input_storage_;
+  std::span<const int> input_;
   int res{};
   std::string ops;
 };
 
+// Register TestOMPTaskSequential and TestOMPTaskParallel as backends "seq" and "omp" of task nesterov_a_test_task_omp
+void register_backends(ppc::core::BackendRegistry<std::string> &registry);
+
 }  // namespace nesterov_a_test_task_omp
\ No newline at end of file
@@ -3,33 +3,26 @@
 
 #include <omp.h>
 
+#include <functional>
 #include <iostream>
 #include <numeric>
-#include <random>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "core/patterns/include/patterns_omp.hpp"
+#include "core/random/include/random.hpp"
+
 using namespace std::chrono_literals;
 
 std::vector<int> nesterov_a_test_task_omp::getRandomVector(int sz) {
-  std::random_device dev;
-  std::mt19937 gen(dev());
-  std::vector<int> vec(sz);
-  for (int i = 0; i < sz; i++) {
-    vec[i] = gen() % 100 + 1;
-  }
-  return vec;
+  return ppc::core::random_vector<int>(sz, 1, 100);
 }
 
 bool nesterov_a_test_task_omp::TestOMPTaskSequential::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_ = acquire_input(0, input_storage_);
   // Init value for output
   res = 1;
   return true;
@@ -63,11 +56,7 @@ bool nesterov_a_test_task_omp::TestOMPTaskSequential::post_processing() {
 bool nesterov_a_test_task_omp::TestOMPTaskParallel::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_ = acquire_input(0, input_storage_);
   // Init value for output
   res = 1;
   return true;
@@ -82,24 +71,14 @@ bool nesterov_a_test_task_omp::TestOMPTaskParallel::validation() {
 bool nesterov_a_test_task_omp::TestOMPTaskParallel::run() {
   internal_order_test();
   double start = omp_get_wtime();
-  auto temp_res = res;
+  ppc::patterns::OpenMP policy;
   if (ops == "+") {
-#pragma omp parallel for reduction(+ : temp_res)
-    for (int i = 0; i < static_cast<int>(input_.size()); i++) {
-      temp_res += input_[i];
-    }
+    res += ppc::patterns::reduce(policy, input_, 0, std::plus<>());
   } else if (ops == "-") {
-#pragma omp parallel for reduction(- : temp_res)
-    for (int i = 0; i < static_cast<int>(input_.size()); i++) {
-      temp_res -= input_[i];
-    }
+    res -= ppc::patterns::reduce(policy, input_, 0, std::plus<>());
   } else if (ops == "*") {
-#pragma omp parallel for reduction(* : temp_res)
-    for (int i = 0; i < static_cast<int>(input_.size()); i++) {
-      temp_res *= input_[i];
-    }
+    res *= ppc::patterns::reduce(policy, input_, 1, std::multiplies<>());
   }
-  res = temp_res;
   double finish = omp_get_wtime();
   std::cout << "How measure time in OpenMP: " << finish - start << std::endl;
   return true;
@@ -110,3 +89,8 @@ bool nesterov_a_test_task_omp::TestOMPTaskParallel::post_processing() {
   reinterpret_cast<int*>(taskData->outputs[0])[0] = res;
   return true;
 }
+
+void nesterov_a_test_task_omp::register_backends(ppc::core::BackendRegistry<std::string> &registry) {
+  registry.add<TestOMPTaskSequential>("nesterov_a_test_task_omp", "seq");
+  registry.add<TestOMPTaskParallel>("nesterov_a_test_task_omp", "omp");
+}
@@ -201,7 +201,37 @@ TEST(Parallel_Operations_STL_Threads, Test_Diff_2) {
   ASSERT_EQ(ref_res[0], par_res[0]);
 }
 
+TEST(Parallel_Operations_STL_Threads, Test_Sum_Selected_Backend) {
+  std::vector<int> vec = nesterov_a_test_task_stl::getRandomVector(100);
+  const auto &registry = ppc::core::BackendRegistry<std::string>::global();
+  std::vector<int> results;
+  // every registered backend, then default one chosen by --backend flag or PPC_BACKEND
+  auto backends = registry.backends("nesterov_a_test_task_stl");
+  backends.emplace_back();
+  for (const auto &backend : backends) {
+    std::vector<int> res(1, 0);
+    std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(vec.data()));
+    taskData->inputs_count.emplace_back(vec.size());
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(res.data()));
+    taskData->outputs_count.emplace_back(res.size());
+    taskData->backend = backend;
+
+    auto task = registry.create("nesterov_a_test_task_stl", taskData, "+");
+    ASSERT_EQ(task->validation(), true);
+    task->pre_processing();
+    task->run();
+    task->post_processing();
+    results.push_back(res[0]);
+  }
+  ASSERT_EQ(results.size(), 3u);
+  ASSERT_EQ(results[0], results[1]);
+  ASSERT_EQ(results[0], results[2]);
+}
+
 int main(int argc, char **argv) {
+  ppc::core::parse_backend_flag(argc, argv);
+  nesterov_a_test_task_stl::register_backends(ppc::core::BackendRegistry<std::string>::global());
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
@@ -2,9 +2,11 @@
 #ifndef TASKS_EXAMPLES_TEST_STD_OPS_STD_H_
 #define TASKS_EXAMPLES_TEST_STD_OPS_STD_H_
 
+#include <span>
 #include <string>
 #include <vector>
 
+#include "core/backend/include/backend.hpp"
 #include "core/task/include/task.hpp"
 
 namespace nesterov_a_test_task_stl {
@@ -21,7 +23,8 @@ class TestSTLTaskSequential : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::vector<int> input_storage_;
+  std::span<const int> input_;
   int res{};
   std::string ops;
 };
@@ -36,11 +39,15 @@ class TestSTLTaskParallel : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::vector<int> input_storage_;
+  std::span<const int> input_;
   int res{};
   std::string ops;
 };
 
+// Register TestSTLTaskSequential and TestSTLTaskParallel as backends "seq" and "stl" of task nesterov_a_test_task_stl
+void register_backends(ppc::core::BackendRegistry<std::string> &registry);
+
 }  // namespace nesterov_a_test_task_stl
 
 #endif  // TASKS_EXAMPLES_TEST_STD_OPS_STD_H_
@@ -1,9 +1,14 @@
 // Copyright 2024 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <cstdlib>
+#include <numeric>
+#include <optional>
 #include <vector>
 
+#include "core/dataset/include/dataset.hpp"
 #include "core/perf/include/perf.hpp"
+#include "core/threading/include/threading.hpp"
 #include "stl/example/include/ops_stl.hpp"
 
 TEST(stl_example_perf_test, test_pipeline_run) {
@@ -25,7 +30,6 @@ TEST(stl_example_perf_test, test_pipeline_run) {
 
   // Create Perf attributes
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-  perfAttr->num_running = 10;
   const auto t0 = std::chrono::high_resolution_clock::now();
   perfAttr->current_timer = [&] {
     auto current_time_point = std::chrono::high_resolution_clock::now();
@@ -62,7 +66,6 @@ TEST(stl_example_perf_test, test_task_run) {
 
   // Create Perf attributes
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-  perfAttr->num_running = 10;
   const auto t0 = std::chrono::high_resolution_clock::now();
   perfAttr->current_timer = [&] {
     auto current_time_point = std::chrono::high_resolution_clock::now();
@@ -80,6 +83,93 @@ TEST(stl_example_perf_test, test_task_run) {
   ASSERT_EQ(count, out[0]);
 }
 
+TEST(stl_example_perf_test, test_scaling_run) {
+  const int count = 1 << 16;
+
+  // Create data, captured int32 dataset file is mapped instead if PPC_PERF_DATASET is set
+  std::vector<int> in;
+  std::optional<ppc::core::MappedDataset> dataset;
+  if (const char *path = std::getenv("PPC_PERF_DATASET")) {
+    dataset.emplace(path);
+    // tasks read input as int, other element types would be reinterpreted
+    ASSERT_TRUE(dataset->type() == ppc::core::DataType::INT32)
+        << "PPC_PERF_DATASET holds " << ppc::core::data_type_name(dataset->type()) << ", test needs int32";
+  } else {
+    in = nesterov_a_test_task_stl::getRandomVector(count);
+  }
+  std::vector<int> out_par(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (dataset) {
+    dataset->attach_input(*taskDataPar);
+  } else {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+    taskDataPar->inputs_count.emplace_back(in.size());
+  }
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(out_par.data()));
+  taskDataPar->outputs_count.emplace_back(out_par.size());
+
+  // Create Task, its pipeline on one thread is the baseline of speedup
+  auto testTaskPar = std::make_shared<nesterov_a_test_task_stl::TestSTLTaskParallel>(taskDataPar, "+");
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perfAttr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+  perfAttr->set_num_threads = [](int num_threads) { ppc::core::set_num_threads(num_threads); };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskPar);
+  perfAnalyzer->scaling_run(perfAttr, perfResults);
+  ppc::core::set_num_threads(0);
+  ppc::core::Perf::print_perf_statistic(perfResults);
+  ASSERT_FALSE(perfResults->scaling.empty());
+  auto input = taskDataPar->input_view<int>(0);
+  ASSERT_EQ(std::accumulate(input.begin(), input.end(), 0), out_par[0]);
+}
+
+TEST(stl_example_perf_test, test_size_sweep) {
+  // Create data, input of every size replaces the previous one when its task is made
+  std::vector<int> in;
+  std::vector<int> out(1, 0);
+  auto make_task = [&](uint64_t size) {
+    in = nesterov_a_test_task_stl::getRandomVector(static_cast<int>(size));
+    std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+    taskDataPar->inputs_count.emplace_back(in.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+    taskDataPar->outputs_count.emplace_back(out.size());
+    return std::make_shared<nesterov_a_test_task_stl::TestSTLTaskParallel>(taskDataPar, "+");
+  };
+
+  // Create Perf attributes, sizes from 2^10 to 2^22 elements by default
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->target_time = 0.1;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perfAttr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf::sweep_run(perfAttr, perfResults, make_task);
+  ppc::core::Perf::print_perf_statistic(perfResults);
+  ASSERT_FALSE(perfResults->complexity.empty());
+  ASSERT_EQ(std::accumulate(in.begin(), in.end(), 0), out[0]);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,35 +1,27 @@
 // Copyright 2023 Nesterov Alexander
 #include "stl/example/include/ops_stl.hpp"
 
-#include <future>
+#include <functional>
 #include <iostream>
 #include <numeric>
-#include <random>
 #include <string>
 #include <thread>
 #include <utility>
 #include <vector>
 
+#include "core/patterns/include/patterns.hpp"
+#include "core/random/include/random.hpp"
+
 using namespace std::chrono_literals;
 
 std::vector<int> nesterov_a_test_task_stl::getRandomVector(int sz) {
-  std::random_device dev;
-  std::mt19937 gen(dev());
-  std::vector<int> vec(sz);
-  for (int i = 0; i < sz; i++) {
-    vec[i] = static_cast<int>(gen()) % 100;
-  }
-  return vec;
+  return ppc::core::random_vector<int>(sz, -99, 99);
 }
 
 bool nesterov_a_test_task_stl::TestSTLTaskSequential::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto *tmp_ptr = reinterpret_cast<int *>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_ = acquire_input(0, input_storage_);
   // Init value for output
   res = 0;
   return true;
@@ -58,33 +50,10 @@ bool nesterov_a_test_task_stl::TestSTLTaskSequential::post_processing() {
   return true;
 }
 
-std::mutex my_mutex;
-
-void atomOps(std::vector<int> vec, const std::string &ops, std::promise<int> &&pr) {
-  auto sz = vec.size();
-  int reduction_elem = 0;
-  if (ops == "+") {
-    for (size_t i = 0; i < sz; i++) {
-      std::lock_guard<std::mutex> my_lock(my_mutex);
-      reduction_elem += vec[i];
-    }
-  } else if (ops == "-") {
-    for (size_t i = 0; i < sz; i++) {
-      std::lock_guard<std::mutex> my_lock(my_mutex);
-      reduction_elem -= vec[i];
-    }
-  }
-  pr.set_value(reduction_elem);
-}
-
 bool nesterov_a_test_task_stl::TestSTLTaskParallel::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto *tmp_ptr = reinterpret_cast<int *>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_ = acquire_input(0, input_storage_);
   // Init value for output
   res = 0;
   return true;
@@ -98,24 +67,13 @@ bool nesterov_a_test_task_stl::TestSTLTaskParallel::validation() {
 
 bool nesterov_a_test_task_stl::TestSTLTaskParallel::run() {
   internal_order_test();
-  const auto nthreads = std::thread::hardware_concurrency();
-  const auto delta = (input_.end() - input_.begin()) / nthreads;
-
-  auto *promises = new std::promise<int>[nthreads];
-  auto *futures = new std::future<int>[nthreads];
-  auto *threads = new std::thread[nthreads];
-
-  for (unsigned i = 0; i < nthreads; i++) {
-    futures[i] = promises[i].get_future();
-    std::vector<int> tmp_vec(input_.begin() + i * delta, input_.begin() + (i + 1) * delta);
-    threads[i] = std::thread(atomOps, tmp_vec, ops, std::move(promises[i]));
-    threads[i].join();
-    res += futures[i].get();
+  // Chunks are reduced on persistent workers of global pool, calling thread takes the first one
+  ppc::patterns::Threads policy;
+  if (ops == "+") {
+    res = ppc::patterns::reduce(policy, input_, 0, std::plus<>());
+  } else if (ops == "-") {
+    res -= ppc::patterns::reduce(policy, input_, 0, std::plus<>());
   }
-
-  delete[] promises;
-  delete[] futures;
-  delete[] threads;
   return true;
 }
 
@@ -124,3 +82,8 @@ bool nesterov_a_test_task_stl::TestSTLTaskParallel::post_processing() {
   reinterpret_cast<int *>(taskData->outputs[0])[0] = res;
   return true;
 }
+
+void nesterov_a_test_task_stl::register_backends(ppc::core::BackendRegistry<std::string> &registry) {
+  registry.add<TestSTLTaskSequential>("nesterov_a_test_task_stl", "seq");
+  registry.add<TestSTLTaskParallel>("nesterov_a_test_task_stl", "stl");
+}
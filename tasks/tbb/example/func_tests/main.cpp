@@ -1,8 +1,13 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <functional>
+#include <numeric>
+#include <span>
+#include <string>
 #include <vector>
 
+#include "core/patterns/include/patterns_tbb.hpp"
 #include "tbb/example/include/ops_tbb.hpp"
 
 TEST(Parallel_Operations_TBB, Test_Sum) {
@@ -195,7 +200,56 @@ TEST(Parallel_Operations_TBB, Test_Mult_2) {
   ASSERT_EQ(ref_res[0], par_res[0]);
 }
 
+TEST(Parallel_Operations_TBB, Test_Patterns_Match_Sequential) {
+  std::vector<int> vec(1001);
+  std::iota(vec.begin(), vec.end(), 1);
+  std::span<const int> view(vec);
+  std::vector<int> expected(vec.size());
+  std::inclusive_scan(vec.begin(), vec.end(), expected.begin());
+  for (int num_threads : {1, 2, 3}) {
+    ppc::patterns::Tbb policy{num_threads};
+    ASSERT_EQ(ppc::patterns::reduce(policy, view, 0, std::plus<>()), expected.back());
+    std::vector<int> prefixes(vec.size());
+    ppc::patterns::inclusive_scan(policy, view, std::span<int>(prefixes), 0, std::plus<>());
+    ASSERT_EQ(prefixes, expected);
+    // concatenation isn't commutative, chunks have to be combined in order
+    auto digits = ppc::patterns::map_reduce(
+        policy, view.first(9), std::string(), [](int value) { return std::to_string(value); }, std::plus<>());
+    ASSERT_EQ(digits, "123456789");
+  }
+}
+
+TEST(Parallel_Operations_TBB, Test_Sum_Selected_Backend) {
+  std::vector<int> vec = nesterov_a_test_task_tbb::getRandomVector(100);
+  const auto &registry = ppc::core::BackendRegistry<std::string>::global();
+  std::vector<int> results;
+  // every registered backend, then default one chosen by --backend flag or PPC_BACKEND
+  auto backends = registry.backends("nesterov_a_test_task_tbb");
+  backends.emplace_back();
+  for (const auto &backend : backends) {
+    std::vector<int> res(1, 0);
+    std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(vec.data()));
+    taskData->inputs_count.emplace_back(vec.size());
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(res.data()));
+    taskData->outputs_count.emplace_back(res.size());
+    taskData->backend = backend;
+
+    auto task = registry.create("nesterov_a_test_task_tbb", taskData, "+");
+    ASSERT_EQ(task->validation(), true);
+    task->pre_processing();
+    task->run();
+    task->post_processing();
+    results.push_back(res[0]);
+  }
+  ASSERT_EQ(results.size(), 3u);
+  ASSERT_EQ(results[0], results[1]);
+  ASSERT_EQ(results[0], results[2]);
+}
+
 int main(int argc, char **argv) {
+  ppc::core::parse_backend_flag(argc, argv);
+  nesterov_a_test_task_tbb::register_backends(ppc::core::BackendRegistry<std::string>::global());
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
@@ -2,9 +2,11 @@
 #ifndef TASKS_EXAMPLES_TEST_TBB_OPS_TBB_H_
 #define TASKS_EXAMPLES_TEST_TBB_OPS_TBB_H_
 
+#include <span>
 #include <string>
 #include <vector>
 
+#include "core/backend/include/backend.hpp"
 #include "core/task/include/task.hpp"
 
 namespace nesterov_a_test_task_tbb {
@@ -21,7 +23,8 @@ class TestTBBTaskSequential : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::vector<int> input_storage_;
+  std::span<const int> input_;
   int res{};
   std::string ops;
 };
@@ -36,11 +39,15 @@ class TestTBBTaskParallel : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::vector<int> input_storage_;
+  std::span<const int> input_;
   int res{};
   std::string ops;
 };
 
+// Register TestTBBTaskSequential and TestTBBTaskParallel as backends "seq" and "tbb" of task nesterov_a_test_task_tbb
+void register_backends(ppc::core::BackendRegistry<std::string> &registry);
+
 }  // namespace nesterov_a_test_task_tbb
 
 #endif  // TASKS_EXAMPLES_TEST_TBB_OPS_TBB_H_
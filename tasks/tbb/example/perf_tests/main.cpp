@@ -2,6 +2,8 @@
 #include <gtest/gtest.h>
 #include <oneapi/tbb.h>
 
+#include <memory>
+#include <numeric>
 #include <vector>
 
 #include "core/perf/include/perf.hpp"
@@ -26,7 +28,6 @@ TEST(tbb_example_perf_test, test_pipeline_run) {
 
   // Create Perf attributes
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-  perfAttr->num_running = 10;
   const auto t0 = oneapi::tbb::tick_count::now();
   perfAttr->current_timer = [&] { return (oneapi::tbb::tick_count::now() - t0).seconds(); };
 
@@ -59,7 +60,6 @@ TEST(tbb_example_perf_test, test_task_run) {
 
   // Create Perf attributes
   auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-  perfAttr->num_running = 10;
   const auto t0 = oneapi::tbb::tick_count::now();
   perfAttr->current_timer = [&] { return (oneapi::tbb::tick_count::now() - t0).seconds(); };
 
@@ -73,6 +73,47 @@ TEST(tbb_example_perf_test, test_task_run) {
   ASSERT_EQ(count + 1, out[0]);
 }
 
+TEST(tbb_example_perf_test, test_scaling_run) {
+  const int count = 1 << 16;
+
+  // Create data
+  std::vector<int> in = nesterov_a_test_task_tbb::getRandomVector(count);
+  std::vector<int> out_par(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskDataPar->inputs_count.emplace_back(in.size());
+  taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t *>(out_par.data()));
+  taskDataPar->outputs_count.emplace_back(out_par.size());
+
+  // Create Task, its pipeline on one thread is the baseline of speedup
+  auto testTaskPar = std::make_shared<nesterov_a_test_task_tbb::TestTBBTaskParallel>(taskDataPar, "+");
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  const auto t0 = oneapi::tbb::tick_count::now();
+  perfAttr->current_timer = [&] { return (oneapi::tbb::tick_count::now() - t0).seconds(); };
+  std::unique_ptr<oneapi::tbb::global_control> control;
+  perfAttr->set_num_threads = [&](int num_threads) {
+    control.reset();
+    control = std::make_unique<oneapi::tbb::global_control>(oneapi::tbb::global_control::max_allowed_parallelism,
+                                                            num_threads);
+  };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(testTaskPar);
+  perfAnalyzer->scaling_run(perfAttr, perfResults);
+  control.reset();
+  ppc::core::Perf::print_perf_statistic(perfResults);
+  ASSERT_FALSE(perfResults->scaling.empty());
+  auto input = taskDataPar->input_view<int>(0);
+  ASSERT_EQ(std::accumulate(input.begin(), input.end(), 1), out_par[0]);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
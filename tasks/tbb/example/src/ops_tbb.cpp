@@ -1,35 +1,26 @@
 // Copyright 2023 Nesterov Alexander
 #include "tbb/example/include/ops_tbb.hpp"
 
-#include <tbb/tbb.h>
-
 #include <functional>
 #include <numeric>
-#include <random>
+#include <span>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "core/patterns/include/patterns_tbb.hpp"
+#include "core/random/include/random.hpp"
+
 using namespace std::chrono_literals;
 
 std::vector<int> nesterov_a_test_task_tbb::getRandomVector(int sz) {
-  std::random_device dev;
-  std::mt19937 gen(dev());
-  std::vector<int> vec(sz);
-  for (int i = 0; i < sz; i++) {
-    vec[i] = gen() % 20 + 1;
-  }
-  return vec;
+  return ppc::core::random_vector<int>(sz, 1, 20);
 }
 
 bool nesterov_a_test_task_tbb::TestTBBTaskSequential::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_ = acquire_input(0, input_storage_);
   // Init value for output
   res = 1;
   return true;
@@ -63,11 +54,7 @@ bool nesterov_a_test_task_tbb::TestTBBTaskSequential::post_processing() {
 bool nesterov_a_test_task_tbb::TestTBBTaskParallel::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_ = acquire_input(0, input_storage_);
   // Init value for output
   res = 1;
   return true;
@@ -81,30 +68,13 @@ bool nesterov_a_test_task_tbb::TestTBBTaskParallel::validation() {
 
 bool nesterov_a_test_task_tbb::TestTBBTaskParallel::run() {
   internal_order_test();
+  ppc::patterns::Tbb policy;
   if (ops == "+") {
-    res += oneapi::tbb::parallel_reduce(
-        oneapi::tbb::blocked_range<std::vector<int>::iterator>(input_.begin(), input_.end()), 0,
-        [](tbb::blocked_range<std::vector<int>::iterator> r, int running_total) {
-          running_total += std::accumulate(r.begin(), r.end(), 0);
-          return running_total;
-        },
-        std::plus<>());
+    res += ppc::patterns::reduce(policy, input_, 0, std::plus<>());
   } else if (ops == "-") {
-    res -= oneapi::tbb::parallel_reduce(
-        oneapi::tbb::blocked_range<std::vector<int>::iterator>(input_.begin(), input_.end()), 0,
-        [](tbb::blocked_range<std::vector<int>::iterator> r, int running_total) {
-          running_total += std::accumulate(r.begin(), r.end(), 0);
-          return running_total;
-        },
-        std::plus<>());
+    res -= ppc::patterns::reduce(policy, input_, 0, std::plus<>());
   } else if (ops == "*") {
-    res *= oneapi::tbb::parallel_reduce(
-        oneapi::tbb::blocked_range<std::vector<int>::iterator>(input_.begin(), input_.end()), 1,
-        [](tbb::blocked_range<std::vector<int>::iterator> r, int running_total) {
-          running_total *= std::accumulate(r.begin(), r.end(), 1, std::multiplies<>());
-          return running_total;
-        },
-        std::multiplies<>());
+    res *= ppc::patterns::reduce(policy, input_, 1, std::multiplies<>());
   }
   return true;
 }
@@ -114,3 +84,8 @@ bool nesterov_a_test_task_tbb::TestTBBTaskParallel::post_processing() {
   reinterpret_cast<int*>(taskData->outputs[0])[0] = res;
   return true;
 }
+
+void nesterov_a_test_task_tbb::register_backends(ppc::core::BackendRegistry<std::string> &registry) {
+  registry.add<TestTBBTaskSequential>("nesterov_a_test_task_tbb", "seq");
+  registry.add<TestTBBTaskParallel>("nesterov_a_test_task_tbb", "tbb");
+}